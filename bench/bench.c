@@ -0,0 +1,391 @@
+//
+//  bench.c
+//  Jason
+//
+//  Parses each file given on the command line a number of times and prints one JSON object per file with the
+//  median and 99th percentile of every measurement, so two builds of jason.h can be compared run to run.
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../jason.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_RUNS 20
+#define BENCH_MAX_LOOKUPS (1 << 20)
+
+typedef struct
+{
+    jasonValue *Object;
+    const char *Key;
+    int32_t KeyLen;
+}
+benchLookup;
+
+typedef struct
+{
+    jasonValue **Roots;
+    size_t NumRoots;
+    benchLookup *Lookups;
+    size_t NumLookups;
+    size_t LookupsSize;
+}
+benchTargets;
+
+// every allocation made by the parser goes through these, with its size kept in front of it
+static size_t bench_Allocs = 0;
+static size_t bench_LiveBytes = 0;
+static size_t bench_PeakBytes = 0;
+
+#define BENCH_HEADER_SIZE 16
+
+static void bench_CountAlloc(size_t oldSize, size_t newSize)
+{
+    bench_Allocs++;
+    bench_LiveBytes += newSize - oldSize;
+    if(bench_LiveBytes > bench_PeakBytes)
+    {
+        bench_PeakBytes = bench_LiveBytes;
+    }
+}
+
+static void *bench_Malloc(size_t *size)
+{
+    char *ptr = malloc(*size + BENCH_HEADER_SIZE);
+    if(ptr == NULL)
+    {
+        *size = 0;
+        return NULL;
+    }
+    
+    memcpy(ptr, size, sizeof(size_t));
+    bench_CountAlloc(0, *size);
+    return ptr + BENCH_HEADER_SIZE;
+}
+
+static void bench_Free(void *ptr)
+{
+    if(ptr != NULL)
+    {
+        size_t size;
+        char *block = (char*)ptr - BENCH_HEADER_SIZE;
+        memcpy(&size, block, sizeof(size_t));
+        bench_LiveBytes -= size;
+        free(block);
+    }
+}
+
+static void *bench_Realloc(void *ptr, size_t *size)
+{
+    size_t oldSize = 0;
+    char *block = NULL;
+    if(ptr != NULL)
+    {
+        block = (char*)ptr - BENCH_HEADER_SIZE;
+        memcpy(&oldSize, block, sizeof(size_t));
+    }
+    
+    char *newBlock = realloc(block, *size + BENCH_HEADER_SIZE);
+    if(newBlock == NULL)
+    {
+        *size = 0;
+        return NULL;
+    }
+    
+    memcpy(newBlock, size, sizeof(size_t));
+    bench_CountAlloc(oldSize, *size);
+    return newBlock + BENCH_HEADER_SIZE;
+}
+
+static double bench_Now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static int bench_CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// "name":{"median_ms":..,"p99_ms":..,"<rateName>":..} where the rate is work per second at the median
+static void bench_PrintSamples(const char *name, double *samples, int32_t runs, double work, const char *rateName)
+{
+    qsort(samples, runs, sizeof(double), bench_CompareDouble);
+    double median = (runs % 2) ? samples[runs / 2] : (samples[runs / 2 - 1] + samples[runs / 2]) / 2;
+    int32_t p99 = (int32_t)((runs * 99 + 99) / 100) - 1;
+    printf(",\"%s\":{\"median_ms\":%.4f,\"p99_ms\":%.4f,\"%s\":%.2f}", name, median * 1e3, samples[p99] * 1e3, rateName, median > 0 ? work / median : 0.0);
+}
+
+static char *bench_ReadFile(const char *path, size_t *length)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return NULL;
+    }
+    
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    char *data = size >= 0 ? malloc((size_t)size + 1) : NULL;
+    if(data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size)
+    {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    
+    fclose(file);
+    *length = (size_t)size;
+    return data;
+}
+
+static void bench_AddLookup(benchTargets *targets, jasonValue *object, jasonValue *key)
+{
+    if(targets->NumLookups >= BENCH_MAX_LOOKUPS)
+    {
+        return;
+    }
+    
+    if(targets->NumLookups == targets->LookupsSize)
+    {
+        targets->LookupsSize = targets->LookupsSize > 0 ? targets->LookupsSize * 2 : 1024;
+        targets->Lookups = realloc(targets->Lookups, targets->LookupsSize * sizeof(benchLookup));
+    }
+    
+    benchLookup *lookup = targets->Lookups + targets->NumLookups++;
+    lookup->Object = object;
+    lookup->Key = jasonValue_GetValue(key);
+    lookup->KeyLen = (int32_t)jasonValue_GetValueLen(key);
+}
+
+// every key of every object, looked up again later in the same order
+static void bench_CollectLookups(benchTargets *targets, jasonValue *value)
+{
+    jasonValueType type = jasonValue_GetType(value);
+    if(type != jasonValueType_Object && type != jasonValueType_Array)
+    {
+        return;
+    }
+    
+    if(type == jasonValueType_Array)
+    {
+        for(jasonValue *child = jasonValue_GetFirstChild(value); child != NULL; child = jasonValue_GetNextSibling(child))
+        {
+            bench_CollectLookups(targets, child);
+        }
+        
+        return;
+    }
+    
+    // keys are chained through Next, each one followed by its value
+    for(jasonValue *key = jasonValue_GetFirstChild(value); key != NULL; key = jasonValue_GetNextSibling(key))
+    {
+        bench_AddLookup(targets, value, key);
+        bench_CollectLookups(targets, key + 1);
+    }
+}
+
+// visit every value through the public accessors, the way a consumer of the tape would
+static size_t bench_Traverse(jasonValue *value, size_t *checksum)
+{
+    size_t count = 1;
+    *checksum += (size_t)jasonValue_GetValueLen(value) + (unsigned char)*value->Value;
+    
+    int32_t isObject = (jasonValue_GetType(value) == jasonValueType_Object);
+    for(jasonValue *child = jasonValue_GetFirstChild(value); child != NULL; child = jasonValue_GetNextSibling(child))
+    {
+        count += bench_Traverse(child, checksum);
+        if(isObject)
+        {
+            count += bench_Traverse(child + 1, checksum);
+        }
+    }
+    
+    return count;
+}
+
+static jasonStatus bench_Parse(jason *jason, jasonBatch *batch, const char *data, size_t length, int32_t isLines)
+{
+    if(isLines)
+    {
+        return jason_DeserializeLines(batch, data, (jasonSize)length);
+    }
+    
+    return jason_Deserialize(jason, data, (jasonSize)length);
+}
+
+static void bench_File(const char *path, int32_t runs, int32_t flags)
+{
+    size_t length = 0;
+    char *data = bench_ReadFile(path, &length);
+    if(data == NULL)
+    {
+        printf("{\"file\":\"%s\",\"error\":\"cannot read file\"}\n", path);
+        return;
+    }
+    
+    size_t pathLen = strlen(path);
+    int32_t isLines = pathLen > 7 && strcmp(path + pathLen - 7, ".ndjson") == 0;
+    double *samples = malloc(runs * sizeof(double));
+    
+    jason jason;
+    jasonBatch batch;
+    memset(&jason, 0, sizeof(jason));
+    memset(&batch, 0, sizeof(batch));
+    jason.Malloc = batch.Malloc = bench_Malloc;
+    jason.Free = batch.Free = bench_Free;
+    jason.Realloc = batch.Realloc = bench_Realloc;
+    jason.Flags = flags;
+    batch.Flags = flags;
+    batch.NumThreads = 1;
+    
+    // a fresh document for every run, so allocation counts and peak memory are those of a cold parse
+    jasonStatus status = jasonStatus_Finished;
+    size_t allocs = 0;
+    size_t peakBytes = 0;
+    for(int32_t r = 0; r < runs && status == jasonStatus_Finished; r++)
+    {
+        bench_Allocs = 0;
+        bench_LiveBytes = 0;
+        bench_PeakBytes = 0;
+        
+        double start = bench_Now();
+        status = bench_Parse(&jason, &batch, data, length, isLines);
+        samples[r] = bench_Now() - start;
+        
+        allocs = bench_Allocs;
+        peakBytes = bench_PeakBytes;
+        if(r < runs - 1)
+        {
+            jason_Cleanup(&jason);
+            jasonBatch_Free(&batch);
+            memset(&jason, 0, sizeof(jason));
+            jason.Malloc = bench_Malloc;
+            jason.Free = bench_Free;
+            jason.Realloc = bench_Realloc;
+            jason.Flags = flags;
+        }
+    }
+    
+    printf("{\"file\":\"%s\",\"bytes\":%zu,\"runs\":%d,\"flags\":%d,\"status\":\"%s\"", path, length, runs, flags, jasonStatus_Describe(status));
+    
+    if(status == jasonStatus_Finished)
+    {
+        benchTargets targets;
+        memset(&targets, 0, sizeof(targets));
+        
+        if(isLines)
+        {
+            targets.NumRoots = batch.NumLines;
+            targets.Roots = malloc(targets.NumRoots * sizeof(jasonValue*) + 1);
+            for(size_t i = 0; i < targets.NumRoots; i++)
+            {
+                targets.Roots[i] = batch.Lines[i].Root;
+            }
+        }
+        else
+        {
+            // keys are looked up with jason_HashLookup, which needs the document that owns the object
+            targets.NumRoots = 1;
+            targets.Roots = malloc(sizeof(jasonValue*));
+            targets.Roots[0] = jason.RootValue;
+            bench_CollectLookups(&targets, jason.RootValue);
+        }
+        
+        printf(",\"allocs\":%zu,\"peak_bytes\":%zu", allocs, peakBytes);
+        bench_PrintSamples("parse", samples, runs, (double)length / 1e6, "mb_s");
+        
+        size_t numValues = 0;
+        size_t checksum = 0;
+        for(int32_t r = 0; r < runs; r++)
+        {
+            numValues = 0;
+            double start = bench_Now();
+            for(size_t i = 0; i < targets.NumRoots; i++)
+            {
+                numValues += bench_Traverse(targets.Roots[i], &checksum);
+            }
+            
+            samples[r] = bench_Now() - start;
+        }
+        
+        bench_PrintSamples("traverse", samples, runs, (double)numValues / 1e6, "mvalues_s");
+        
+        if(targets.NumLookups > 0)
+        {
+            size_t found = 0;
+            for(int32_t r = 0; r < runs; r++)
+            {
+                found = 0;
+                double start = bench_Now();
+                for(size_t i = 0; i < targets.NumLookups; i++)
+                {
+                    benchLookup *lookup = targets.Lookups + i;
+                    found += jason_HashLookup(&jason, lookup->Object, lookup->Key, lookup->KeyLen) != NULL;
+                }
+                
+                samples[r] = bench_Now() - start;
+            }
+            
+            bench_PrintSamples("lookup", samples, runs, (double)targets.NumLookups / 1e6, "mops_s");
+            printf(",\"lookups\":%zu,\"found\":%zu", targets.NumLookups, found);
+        }
+        
+        printf(",\"values\":%zu,\"checksum\":%zu", numValues, checksum);
+        free(targets.Roots);
+        free(targets.Lookups);
+    }
+    
+    printf("}\n");
+    fflush(stdout);
+    
+    jason_Cleanup(&jason);
+    jasonBatch_Free(&batch);
+    free(samples);
+    free(data);
+}
+
+int main(int argc, const char *argv[])
+{
+    int32_t runs = BENCH_DEFAULT_RUNS;
+    int32_t flags = 0;
+    int32_t first = 1;
+    
+    while(first + 1 < argc && argv[first][0] == '-')
+    {
+        if(strcmp(argv[first], "-r") == 0)
+        {
+            runs = atoi(argv[first + 1]);
+        }
+        else if(strcmp(argv[first], "-f") == 0)
+        {
+            flags = atoi(argv[first + 1]);
+        }
+        else
+        {
+            break;
+        }
+        
+        first += 2;
+    }
+    
+    if(first >= argc || runs < 1)
+    {
+        fprintf(stderr, "usage: %s [-r runs] [-f jasonFlags] file.json|file.ndjson...\n", argv[0]);
+        return 2;
+    }
+    
+    for(int32_t i = first; i < argc; i++)
+    {
+        bench_File(argv[i], runs, flags);
+    }
+    
+    return 0;
+}
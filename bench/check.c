@@ -0,0 +1,570 @@
+//
+//  check.c
+//  Jason
+//
+//  Parses documents the ways of calling jason_Deserialize could disagree on, prints one JSON line per case where they do
+//  and exits with 1 if there were any. Pieces of a parallel parse are cut far smaller than by default, so short documents
+//  are split across threads, and the tapes of generated arrays are compared with the sequential ones under every flag.
+//
+
+#define JASON_PARALLEL_MIN_BYTES 64
+
+#include "../jason.h"
+#include <stdio.h>
+
+#define CHECK_DOCUMENTS 300
+#define CHECK_MAX_DEPTH 4
+
+static int32_t check_Failures = 0;
+static uint64_t check_State = 0x9E3779B97F4A7C15ull;
+
+// xorshift64, the same documents every run
+static uint32_t check_Random(uint32_t range)
+{
+    check_State ^= check_State << 13;
+    check_State ^= check_State >> 7;
+    check_State ^= check_State << 17;
+    return (uint32_t)(check_State >> 32) % range;
+}
+
+static void check_Fail(const char *what, const char *doc, size_t length, jasonStatus got, jasonStatus expected)
+{
+    printf("{\"check\":\"%s\",\"doc\":\"", what);
+    for(size_t i = 0; i < length && i < 80; i++)
+    {
+        unsigned char c = (unsigned char)doc[i];
+        printf((c == '"' || c == '\\') ? "\\%c" : (c < 0x20) ? "\\u%04x" : "%c", c);
+    }
+    
+    printf("\",\"status\":\"%s\",\"expected\":\"%s\"}\n", jasonStatus_Describe(got), jasonStatus_Describe(expected));
+    check_Failures++;
+}
+
+static jasonStatus check_Parse(const char *doc, size_t length, uint32_t flags, const jasonProjection *projection, int32_t numThreads)
+{
+    jason jason;
+    memset(&jason, 0, sizeof(jason));
+    jason.Flags = flags;
+    jason.Projection = projection;
+    
+    jasonStatus status = (numThreads > 1) ? jason_DeserializeParallel(&jason, doc, (jasonSize)length, numThreads) : jason_Deserialize(&jason, doc, (jasonSize)length);
+    jason_Cleanup(&jason);
+    return status;
+}
+
+// strict mode turns down a comma before a closing bracket however the parse gets there: after a member that
+// a projection passed over, or at the start of a piece of a parallel parse. What is inside a value passed over is
+// not checked, so every comma here trails in what is kept
+static void check_TrailingCommas(void)
+{
+    static const char *docs[] =
+    {
+        "[1,]", "{\"a\":1,}", "{\"skip\":2,}", "[{\"keep\":1},]", "{\"keep\":{\"skip\":2,}}", "[[1],2,]",
+        "[]", "{}", "[1]", "{\"skip\":2}", "[{\"keep\":1}]", "{\"keep\":[1,],\"skip\":2}"
+    };
+    
+    const char *pointers[] = { "/keep" };
+    jasonProjection projection;
+    jasonProjection_Compile(&projection, pointers, 1);
+    
+    for(size_t i = 0; i < sizeof(docs) / sizeof(docs[0]); i++)
+    {
+        size_t length = strlen(docs[i]);
+        jasonStatus expected = check_Parse(docs[i], length, jasonFlag_Strict, NULL, 1);
+        jasonStatus projected = check_Parse(docs[i], length, jasonFlag_Strict, &projection, 1);
+        if(projected != expected)
+        {
+            check_Fail("strict projection", docs[i], length, projected, expected);
+        }
+    }
+    
+    jasonProjection_Free(&projection);
+    
+    // the cut lands on a root comma when the last element is long enough to fill a piece of its own
+    char doc[4 * JASON_PARALLEL_MIN_BYTES + 16];
+    for(int32_t trailing = 0; trailing < 2; trailing++)
+    {
+        char *it = doc;
+        it += sprintf(it, "[1,\"");
+        memset(it, 'x', 3 * JASON_PARALLEL_MIN_BYTES);
+        it += 3 * JASON_PARALLEL_MIN_BYTES;
+        it += sprintf(it, trailing ? "\",]" : "\"]");
+        
+        size_t length = (size_t)(it - doc);
+        jasonStatus expected = check_Parse(doc, length, jasonFlag_Strict, NULL, 1);
+        jasonStatus parallel = check_Parse(doc, length, jasonFlag_Strict, NULL, 2);
+        if(parallel != expected || (expected == jasonStatus_Finished) == trailing)
+        {
+            check_Fail("strict parallel", doc, length, parallel, expected);
+        }
+    }
+}
+
+// a projection keeps the union of its paths: a key or index next to a wildcard keeps what both lead to, in
+// whichever order the paths were added, and the other keys only what the wildcard does
+static void check_Projection(void)
+{
+    static const char *pointers[][2] =
+    {
+        { "/a/*/x", "/a/0/y" }, { "/a/0/y", "/a/*/x" }, { "/a/*", "/a/0/y" }, { "/*/1/y", "/a/*/x" }, { "/*/0/x", "/a/*/y" }
+    };
+    
+    static const char *expected[] =
+    {
+        "{\"a\":[{\"x\":1,\"y\":2},{\"x\":4}]}",
+        "{\"a\":[{\"x\":1,\"y\":2},{\"x\":4}]}",
+        "{\"a\":[{\"x\":1,\"y\":2,\"z\":3},{\"x\":4,\"y\":5}]}",
+        "{\"a\":[{\"x\":1},{\"x\":4,\"y\":5}]}",
+        "{\"a\":[{\"x\":1,\"y\":2},{\"y\":5}]}"
+    };
+    
+    static const char doc[] = "{\"a\":[{\"x\":1,\"y\":2,\"z\":3},{\"x\":4,\"y\":5}]}";
+    
+    for(size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        jasonProjection projection;
+        jasonProjection_Compile(&projection, pointers[i], 2);
+        
+        jason jason;
+        memset(&jason, 0, sizeof(jason));
+        jason.Projection = &projection;
+        jasonWriter writer;
+        memset(&writer, 0, sizeof(writer));
+        
+        jasonStatus status = jason_Deserialize(&jason, doc, (jasonSize)(sizeof(doc) - 1));
+        if(status == jasonStatus_Finished)
+        {
+            status = jason_Serialize(&jason, &writer);
+        }
+        
+        if(status != jasonStatus_Finished || writer.Used != strlen(expected[i]) || memcmp(writer.Buffer, expected[i], writer.Used) != 0)
+        {
+            check_Fail(pointers[i][1], writer.Buffer != NULL ? writer.Buffer : "", writer.Used, status, jasonStatus_Finished);
+        }
+        
+        jasonWriter_Free(&writer);
+        jason_Cleanup(&jason);
+        jasonProjection_Free(&projection);
+    }
+}
+
+// what strict mode turns down is turned down however deep it is, in containers jasonFlag_Lazy passes over too
+static void check_StrictLazy(void)
+{
+    static const char *docs[] =
+    {
+        "[[1,]]", "{\"a\":{\"b\":01}}", "[[\"a\tb\"]]", "[[\"\xff\"]]", "[{\"a\":[\"\\x\"]}]", "[[1.]]", "[{\"a\":1,}]",
+        "[[1,2],{\"a\":[true,null,\"\\u00e9\xc3\xa9\"]}]", "[[],{}]", "[[-0.5e+3]]"
+    };
+    
+    const size_t numRejected = 7;
+    for(size_t i = 0; i < sizeof(docs) / sizeof(docs[0]); i++)
+    {
+        size_t length = strlen(docs[i]);
+        jasonStatus expected = (i < numRejected) ? jasonStatus_UnexpectedCharacter : jasonStatus_Finished;
+        jasonStatus status = check_Parse(docs[i], length, jasonFlag_Strict, NULL, 1);
+        jasonStatus lazy = check_Parse(docs[i], length, jasonFlag_Strict | jasonFlag_Lazy, NULL, 1);
+        if(status != expected || lazy != expected)
+        {
+            check_Fail("strict lazy", docs[i], length, (status != expected) ? status : lazy, expected);
+        }
+    }
+}
+
+// a random value with the characters a cut has to get right: commas and brackets in strings, escaped quotes and
+// backslashes, and objects large enough to be indexed
+static char *check_Value(char *it, int32_t depth)
+{
+    static const char *strings[] = { "\"a\"", "\"],[\"", "\"{,}\"", "\"\\\"\"", "\"\\\\\"", "\"\\u00e9,\"", "\"\"" };
+    static const char *numbers[] = { "0", "-7", "42", "3.25", "-1e-3", "1E+30", "18446744073709551615", "9007199254740993" };
+    static const char *spaces[] = { "", " ", "\n", " \t " };
+    
+    uint32_t kind = check_Random(depth < CHECK_MAX_DEPTH ? 8 : 5);
+    switch(kind)
+    {
+        case 0:
+        case 1:
+            return it + sprintf(it, "%s", strings[check_Random(sizeof(strings) / sizeof(strings[0]))]);
+            
+        case 2:
+        case 3:
+            return it + sprintf(it, "%s", numbers[check_Random(sizeof(numbers) / sizeof(numbers[0]))]);
+            
+        case 4:
+            return it + sprintf(it, "%s", check_Random(3) == 0 ? "null" : check_Random(2) ? "true" : "false");
+            
+        case 5:
+        case 6:
+        {
+            uint32_t numMembers = check_Random(3) == 0 ? 12 + check_Random(20) : check_Random(5);
+            *it++ = '{';
+            for(uint32_t i = 0; i < numMembers; i++)
+            {
+                it += sprintf(it, "%s%s\"k%u\"%s:", i > 0 ? "," : "", spaces[check_Random(4)], check_Random(40), spaces[check_Random(4)]);
+                it = check_Value(it, depth + 1);
+            }
+            
+            *it++ = '}';
+            return it;
+        }
+            
+        default:
+        {
+            uint32_t numElements = check_Random(6);
+            *it++ = '[';
+            for(uint32_t i = 0; i < numElements; i++)
+            {
+                it += sprintf(it, "%s%s", i > 0 ? "," : "", spaces[check_Random(4)]);
+                it = check_Value(it, depth + 1);
+            }
+            
+            *it++ = ']';
+            return it;
+        }
+    }
+}
+
+// a root array of random values, then for some documents one of the errors a piece can end up holding
+static size_t check_Document(char *doc)
+{
+    char *it = doc;
+    uint32_t numElements = 1 + check_Random(40);
+    *it++ = '[';
+    for(uint32_t i = 0; i < numElements; i++)
+    {
+        if(i > 0)
+        {
+            *it++ = ',';
+        }
+        
+        it = check_Value(it, 1);
+    }
+    
+    *it++ = ']';
+    size_t length = (size_t)(it - doc);
+    
+    static const char *errors[] = { ",", "]", "}", ":", "\"", "\\", "01", "1.", "\"\\x\"", "\"\t\"", "tru", ",]" };
+    switch(check_Random(4))
+    {
+        case 0:
+        {
+            // cut short
+            return 1 + check_Random((uint32_t)length - 1);
+        }
+            
+        case 1:
+        {
+            // something put in at a random place
+            const char *error = errors[check_Random(sizeof(errors) / sizeof(errors[0]))];
+            size_t at = 1 + check_Random((uint32_t)length - 1);
+            size_t errorLen = strlen(error);
+            memmove(doc + at + errorLen, doc + at, length - at);
+            memcpy(doc + at, error, errorLen);
+            return length + errorLen;
+        }
+            
+        default:
+            return length;
+    }
+}
+
+// the tape, decoded numbers and key lookups of the parallel parse against the sequential one
+static int32_t check_SameDocument(jason *sequential, jason *parallel)
+{
+    if(sequential->NumValues != parallel->NumValues)
+    {
+        return 0;
+    }
+    
+    for(jasonSize i = 0; i < sequential->NumValues; i++)
+    {
+        jasonValue *expected = sequential->RootValue + i;
+        jasonValue *value = parallel->RootValue + i;
+        if(value->Value != expected->Value || value->ValueLen != expected->ValueLen || value->Next != expected->Next)
+        {
+            return 0;
+        }
+        
+        if(sequential->Flags & jasonFlag_DecodeNumbers)
+        {
+            jasonNumber *expectedNumber = sequential->Numbers + i;
+            jasonNumber *number = parallel->Numbers + i;
+            if(jasonValue_GetType(expected) == jasonValueType_Number && (number->Type != expectedNumber->Type || number->Uint64 != expectedNumber->Uint64))
+            {
+                return 0;
+            }
+        }
+        
+        if(jasonValue_GetType(expected) != jasonValueType_Object || expected->ValueLen <= 0)
+        {
+            continue;
+        }
+        
+        if((jason_FindObjectIndex(sequential, i) != NULL) != (jason_FindObjectIndex(parallel, i) != NULL))
+        {
+            return 0;
+        }
+        
+        for(jasonValue *key = expected + 1; ; key += key->Next)
+        {
+            jasonValue *found = jason_HashLookup(sequential, expected, jasonValue_GetValue(key), (int32_t)jasonValue_GetValueLen(key));
+            jasonValue *parallelFound = jason_HashLookup(parallel, value, jasonValue_GetValue(key), (int32_t)jasonValue_GetValueLen(key));
+            if(found == NULL || parallelFound == NULL || found - sequential->RootValue != parallelFound - parallel->RootValue)
+            {
+                return 0;
+            }
+            
+            if(key->Next == 0)
+            {
+                break;
+            }
+        }
+    }
+    
+    return 1;
+}
+
+// jason_DeserializeParallel promises the sequential result, errors included, whatever the flags and the cuts
+static void check_Parallel(void)
+{
+    static const uint32_t flags[] = { jasonFlag_StructuralIndex, jasonFlag_PreCount, jasonFlag_DecodeNumbers, jasonFlag_Lazy, jasonFlag_Strict };
+    static const int32_t threads[] = { 2, 3, 8 };
+    size_t docSize = 1024 * 1024;
+    char *doc = malloc(docSize);
+    
+    for(int32_t d = 0; d < CHECK_DOCUMENTS; d++)
+    {
+        size_t length = check_Document(doc);
+        
+        for(uint32_t combination = 0; combination < (1u << 5); combination++)
+        {
+            uint32_t docFlags = 0;
+            for(int32_t f = 0; f < 5; f++)
+            {
+                docFlags |= (combination & (1u << f)) ? flags[f] : 0;
+            }
+            
+            jason sequential;
+            memset(&sequential, 0, sizeof(sequential));
+            sequential.Flags = docFlags;
+            jasonStatus expected = jason_Deserialize(&sequential, doc, (jasonSize)length);
+            
+            for(size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+            {
+                jason parallel;
+                memset(&parallel, 0, sizeof(parallel));
+                parallel.Flags = docFlags;
+                jasonStatus status = jason_DeserializeParallel(&parallel, doc, (jasonSize)length, threads[t]);
+                
+                if(status != expected || (status == jasonStatus_Finished && !check_SameDocument(&sequential, &parallel)))
+                {
+                    char what[64];
+                    sprintf(what, "parallel flags %u threads %d", docFlags, threads[t]);
+                    check_Fail(what, doc, length, status, expected);
+                }
+                
+                jason_Cleanup(&parallel);
+            }
+            
+            jason_Cleanup(&sequential);
+        }
+    }
+    
+    free(doc);
+}
+
+// a line that fails only sets its own status, with no values, in a batch that otherwise parses
+static void check_Lines(void)
+{
+    static const char lines[] = "[1,2]\n[1,\n\n{\"a\":true}\n]\n";
+    static const jasonStatus expected[] = { jasonStatus_Finished, jasonStatus_UnexpectedEndOfString, jasonStatus_Finished, jasonStatus_UnexpectedCharacter };
+    
+    jasonBatch batch;
+    memset(&batch, 0, sizeof(batch));
+    jasonStatus status = jason_DeserializeLines(&batch, lines, (jasonSize)(sizeof(lines) - 1));
+    if(status != jasonStatus_Finished || batch.NumLines != 4)
+    {
+        check_Fail("lines", lines, sizeof(lines) - 1, status, jasonStatus_Finished);
+    }
+    
+    for(jasonSize i = 0; i < batch.NumLines && i < 4; i++)
+    {
+        jasonLine *line = batch.Lines + i;
+        if(line->Status != expected[i] || (line->Root != NULL) != (expected[i] == jasonStatus_Finished))
+        {
+            check_Fail("line", lines + line->Offset, strcspn(lines + line->Offset, "\n"), line->Status, expected[i]);
+        }
+    }
+    
+    jasonBatch_Free(&batch);
+}
+
+static jasonStatus check_CountDiff(void *context, jasonDiffKind kind, const char *path, size_t pathLen, jasonValue *before, jasonValue *after)
+{
+    (void)kind; (void)path; (void)pathLen; (void)before; (void)after;
+    (*(int32_t*)context)++;
+    return jasonStatus_Continue;
+}
+
+// numbers are one value only when they are exactly, never because they round to the same double, and jason_Diff
+// reports a change even where the digests of both sides were made to collide
+static void check_Numbers(void)
+{
+    static const char *pairs[][2] =
+    {
+        { "[1e400]", "[2e400]" },
+        { "[18446744073709551616]", "[18446744073709551617]" },
+        { "9007199254740993.0", "9007199254740992" },
+        { "[0.1]", "[0.10000000000000001]" },
+        { "[1,-0,0.1,12.5,1e2]", "[1.0,0,1e-1,125e-1,100]" },
+        { "[18446744073709551616]", "[1.8446744073709551616e19]" },
+        { "[1e400]", "[10e399]" },
+    };
+    
+    for(size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+    {
+        jason a, b;
+        memset(&a, 0, sizeof(a));
+        memset(&b, 0, sizeof(b));
+        jasonStatus status = jason_Deserialize(&a, pairs[i][0], (jasonSize)strlen(pairs[i][0]));
+        status = (status == jasonStatus_Finished) ? jason_Deserialize(&b, pairs[i][1], (jasonSize)strlen(pairs[i][1])) : status;
+        
+        // the first four pairs differ, the rest are the same numbers written another way
+        int32_t expected = (i >= 4);
+        int32_t numChanges = 0;
+        if(status == jasonStatus_Finished)
+        {
+            status = jason_Diff(&a, NULL, &b, NULL, check_CountDiff, &numChanges);
+        }
+        
+        if(status != jasonStatus_Finished || jason_Equal(&a, NULL, &b, NULL) != expected || (numChanges == 0) != expected)
+        {
+            check_Fail(expected ? "numbers equal" : "numbers differ", pairs[i][1], strlen(pairs[i][1]), status, jasonStatus_Finished);
+        }
+        
+        jason_Cleanup(&a);
+        jason_Cleanup(&b);
+    }
+    
+    static const char before[] = "{\"a\":[1,2],\"b\":\"x\"}";
+    static const char after[] = "{\"a\":[1,3],\"b\":\"y\"}";
+    jason a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    jason_Deserialize(&a, before, (jasonSize)(sizeof(before) - 1));
+    jason_Deserialize(&b, after, (jasonSize)(sizeof(after) - 1));
+    jason_ComputeDigests(&a);
+    jason_ComputeDigests(&b);
+    memcpy(b.Digests, a.Digests, a.NumValues * sizeof(uint64_t));
+    
+    int32_t numChanges = 0;
+    jasonStatus status = jason_Diff(&a, NULL, &b, NULL, check_CountDiff, &numChanges);
+    if(status != jasonStatus_Finished || numChanges != 2)
+    {
+        check_Fail("diff of colliding digests", after, sizeof(after) - 1, status, jasonStatus_Finished);
+    }
+    
+    jason_Cleanup(&a);
+    jason_Cleanup(&b);
+    
+    // an index files the numbers that round to one double under keys of their own, and 0.1 under its digits
+    static const char elements[] = "[{\"k\":1e400},{\"k\":2e400},{\"k\":9007199254740993},{\"k\":9007199254740992.0},{\"k\":0.1},{\"k\":1e-1}]";
+    static const jasonSize expected[] = { 1, 1, 1, 1, 2, 2 };
+    jasonValueIndex *index = NULL;
+    memset(&a, 0, sizeof(a));
+    status = jason_Deserialize(&a, elements, (jasonSize)(sizeof(elements) - 1));
+    status = (status == jasonStatus_Finished) ? jason_BuildIndex(&a, a.RootValue, "/k", 2, jasonIndexFlag_None, &index) : status;
+    
+    jasonSize i = 0;
+    jasonValue **found = NULL;
+    for(jasonValue *element = (status == jasonStatus_Finished) ? jasonValue_GetFirstChild(a.RootValue) : NULL; element != NULL; element = jasonValue_GetNextSibling(element), i++)
+    {
+        if(jason_IndexFindValue(index, jasonValue_GetFirstChild(element) + 1, &found) != expected[i])
+        {
+            check_Fail("index of numbers", elements, sizeof(elements) - 1, status, jasonStatus_Finished);
+        }
+    }
+    
+    if(status != jasonStatus_Finished || i != 6 || jason_IndexFindDouble(index, 0.1, &found) != 2)
+    {
+        check_Fail("index of numbers", elements, sizeof(elements) - 1, status, jasonStatus_Finished);
+    }
+    
+    jason_Cleanup(&a);
+}
+
+static jasonStatus check_Serialize(jason *jason, jasonWriter *writer, jasonStatus status)
+{
+    memset(writer, 0, sizeof(jasonWriter));
+    return (status == jasonStatus_Finished) ? jason_Serialize(jason, writer) : status;
+}
+
+// a projection keeps the same values when the document is fed in chunks, cut anywhere: inside a key it has to decide
+// on, or inside a value it passes over, which can run on across many chunks. An error inside a value passed over
+// may be reported as another status, as long as both fail
+static void check_ProjectionChunks(void)
+{
+    static const char *pointers[] = { "/0", "/*/k3", "/*/*/k1", "/2/*", "/*/k7/*/k9" };
+    jasonProjection projection;
+    jasonProjection_Compile(&projection, pointers, sizeof(pointers) / sizeof(pointers[0]));
+    
+    size_t docSize = 1024 * 1024;
+    char *doc = malloc(docSize);
+    
+    for(int32_t d = 0; d < CHECK_DOCUMENTS; d++)
+    {
+        size_t length = check_Document(doc);
+        
+        jason whole;
+        memset(&whole, 0, sizeof(whole));
+        whole.Projection = &projection;
+        jasonWriter expected;
+        jasonStatus expectedStatus = check_Serialize(&whole, &expected, jason_Deserialize(&whole, doc, (jasonSize)length));
+        
+        size_t chunk = 1 + check_Random(d % 2 ? 8 : 300);
+        jason fed;
+        memset(&fed, 0, sizeof(fed));
+        fed.Projection = &projection;
+        jasonStatus status = jason_Begin(&fed);
+        for(size_t offset = 0; offset < length && status == jasonStatus_Continue; offset += chunk)
+        {
+            status = jason_Feed(&fed, doc + offset, (jasonSize)(length - offset < chunk ? length - offset : chunk));
+        }
+        
+        jasonWriter writer;
+        status = check_Serialize(&fed, &writer, (status == jasonStatus_Continue) ? jason_End(&fed) : status);
+        
+        int32_t isSame = (status == jasonStatus_Finished) == (expectedStatus == jasonStatus_Finished);
+        if(isSame && status == jasonStatus_Finished)
+        {
+            isSame = writer.Used == expected.Used && memcmp(writer.Buffer, expected.Buffer, writer.Used) == 0;
+        }
+        
+        if(!isSame)
+        {
+            char what[64];
+            sprintf(what, "projection chunks of %zu", chunk);
+            check_Fail(what, doc, length, status, expectedStatus);
+        }
+        
+        jasonWriter_Free(&expected);
+        jasonWriter_Free(&writer);
+        jason_Cleanup(&whole);
+        jason_Cleanup(&fed);
+    }
+    
+    free(doc);
+    jasonProjection_Free(&projection);
+}
+
+int main(void)
+{
+    check_TrailingCommas();
+    check_StrictLazy();
+    check_Lines();
+    check_Projection();
+    check_ProjectionChunks();
+    check_Numbers();
+    check_Parallel();
+    return check_Failures > 0;
+}
@@ -0,0 +1,147 @@
+//
+//  collisions.c
+//  Jason
+//
+//  Parses objects whose keys all share one hash under the old unseeded 33 * hash + c function, a hash-flooding payload,
+//  and prints one JSON line per size. With that hash plugged in the keys fill a single probe sequence, so the time per key
+//  shows whether inserts and lookups stay linear; the seeded default hash is measured on the same keys alongside.
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../jason.h"
+#include <stdio.h>
+#include <time.h>
+
+#define COLLISIONS_DEFAULT_RUNS 5
+#define COLLISIONS_MIN_BITS 10
+#define COLLISIONS_MAX_BITS 16
+
+// the default hash before it was seeded
+static uint32_t collisions_Djb(char *key, size_t bytes)
+{
+    uint32_t hash = 5831;
+    for(size_t i = 0; i < bytes; i++)
+    {
+        hash = 33 * hash + key[i];
+    }
+    
+    return hash;
+}
+
+static double collisions_Now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// "Ab" and "BA" hash alike under collisions_Djb, so every string of n such pairs does too: 2^n keys with one hash
+static char *collisions_Document(int32_t bits, size_t *length)
+{
+    size_t numKeys = (size_t)1 << bits;
+    char *doc = malloc(numKeys * (2 * bits + 16) + 2);
+    char *it = doc;
+    
+    *it++ = '{';
+    for(size_t k = 0; k < numKeys; k++)
+    {
+        *it++ = (k > 0) ? ',' : '"';
+        if(k > 0)
+        {
+            *it++ = '"';
+        }
+        
+        for(int32_t b = 0; b < bits; b++)
+        {
+            memcpy(it, ((k >> b) & 1) ? "BA" : "Ab", 2);
+            it += 2;
+        }
+        
+        it += sprintf(it, "\":%zu", k);
+    }
+    
+    *it++ = '}';
+    *length = (size_t)(it - doc);
+    return doc;
+}
+
+static void collisions_Measure(const char *hashName, jasonHashCb_t hash, const char *doc, size_t length, int32_t bits, int32_t runs)
+{
+    size_t numKeys = (size_t)1 << bits;
+    double bestParse = 0;
+    double bestLookup = 0;
+    size_t found = 0;
+    int32_t sorted = 0;
+    jasonStatus status = jasonStatus_Finished;
+    
+    for(int32_t r = 0; r < runs && status == jasonStatus_Finished; r++)
+    {
+        jason jason;
+        memset(&jason, 0, sizeof(jason));
+        jason.Hash = hash;
+        
+        double start = collisions_Now();
+        status = jason_Deserialize(&jason, doc, (jasonSize)length);
+        double parsed = collisions_Now();
+        
+        found = 0;
+        if(status == jasonStatus_Finished)
+        {
+            // every key once, in document order
+            for(jasonValue *key = jason.RootValue + 1; ; key += key->Next)
+            {
+                found += jason_HashLookup(&jason, jason.RootValue, jasonValue_GetValue(key), (int32_t)jasonValue_GetValueLen(key)) == key + 1;
+                if(key->Next == 0)
+                {
+                    break;
+                }
+            }
+            
+            jasonObjectIndex *index = jason_FindObjectIndex(&jason, 0);
+            sorted = (index != NULL && index->Sorted);
+        }
+        
+        double looked = collisions_Now();
+        if(r == 0 || parsed - start < bestParse)
+        {
+            bestParse = parsed - start;
+        }
+        
+        if(r == 0 || looked - parsed < bestLookup)
+        {
+            bestLookup = looked - parsed;
+        }
+        
+        jason_Cleanup(&jason);
+    }
+    
+    printf("{\"hash\":\"%s\",\"keys\":%zu,\"bytes\":%zu,\"status\":\"%s\",\"sorted\":%s,\"found\":%zu,\"parse_ns_per_key\":%.1f,\"lookup_ns_per_key\":%.1f}\n", hashName, numKeys, length, jasonStatus_Describe(status), sorted ? "true" : "false", found, bestParse * 1e9 / numKeys, bestLookup * 1e9 / numKeys);
+    fflush(stdout);
+}
+
+int main(int argc, const char *argv[])
+{
+    int32_t runs = COLLISIONS_DEFAULT_RUNS;
+    if(argc == 3 && strcmp(argv[1], "-r") == 0)
+    {
+        runs = atoi(argv[2]);
+    }
+    
+    if(runs < 1 || (argc != 1 && argc != 3))
+    {
+        fprintf(stderr, "usage: %s [-r runs]\n", argv[0]);
+        return 2;
+    }
+    
+    for(int32_t bits = COLLISIONS_MIN_BITS; bits <= COLLISIONS_MAX_BITS; bits += 2)
+    {
+        size_t length = 0;
+        char *doc = collisions_Document(bits, &length);
+        collisions_Measure("djb", collisions_Djb, doc, length, bits, runs);
+        collisions_Measure("default", NULL, doc, length, bits, runs);
+        free(doc);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,262 @@
+//
+//  corpus.c
+//  Jason
+//
+//  Writes the benchmark corpus: one file per document shape and size, the same bytes on every run and machine.
+//
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct
+{
+    char *Data;
+    size_t Used;
+    size_t Size;
+    uint64_t Seed;
+}
+corpusBuffer;
+
+typedef void(*corpusRecordCb_t)(corpusBuffer *buffer, long long index);
+
+typedef struct
+{
+    const char *Name;
+    const char *Extension;
+    const char *Begin;
+    const char *Separator;
+    const char *End;
+    corpusRecordCb_t Record;
+}
+corpusShape;
+
+typedef struct
+{
+    const char *Name;
+    size_t Bytes;
+}
+corpusSize;
+
+static const char *corpus_Words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "jason", "parser", "tape", "value", "quick", "brown", "fox", "jumps", "over", "lazy", "dog" };
+
+// splitmix64, so the corpus does not depend on the C library's rand()
+static uint64_t corpus_Random(corpusBuffer *buffer)
+{
+    uint64_t z = (buffer->Seed += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static long long corpus_Range(corpusBuffer *buffer, long long low, long long high)
+{
+    return low + (long long)(corpus_Random(buffer) % (uint64_t)(high - low + 1));
+}
+
+static double corpus_Uniform(corpusBuffer *buffer, double low, double high)
+{
+    return low + (high - low) * (double)(corpus_Random(buffer) >> 11) / (double)(1ull << 53);
+}
+
+static void corpus_Reserve(corpusBuffer *buffer, size_t bytes)
+{
+    if(buffer->Used + bytes + 1 > buffer->Size)
+    {
+        size_t newSize = buffer->Size > 0 ? buffer->Size * 2 : 1 << 16;
+        while(newSize < buffer->Used + bytes + 1)
+        {
+            newSize *= 2;
+        }
+        
+        buffer->Data = realloc(buffer->Data, newSize);
+        if(buffer->Data == NULL)
+        {
+            fprintf(stderr, "corpus: out of memory\n");
+            exit(1);
+        }
+        
+        buffer->Size = newSize;
+    }
+}
+
+static void corpus_Append(corpusBuffer *buffer, const char *format, ...)
+{
+    for(;;)
+    {
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buffer->Data + buffer->Used, buffer->Size - buffer->Used, format, args);
+        va_end(args);
+        
+        if(len >= 0 && buffer->Used + (size_t)len < buffer->Size)
+        {
+            buffer->Used += len;
+            return;
+        }
+        
+        corpus_Reserve(buffer, len > 0 ? (size_t)len : 256);
+    }
+}
+
+static void corpus_AppendText(corpusBuffer *buffer, int numWords)
+{
+    for(int i = 0; i < numWords; i++)
+    {
+        corpus_Append(buffer, "%s%s", i > 0 ? " " : "", corpus_Words[corpus_Range(buffer, 0, sizeof(corpus_Words) / sizeof(corpus_Words[0]) - 1)]);
+    }
+}
+
+// a status update in the style of the twitter API: mixed types, nested user objects, short arrays
+static void corpus_Twitter(corpusBuffer *buffer, long long index)
+{
+    long long id = 1000000000000000000LL + index * 7919;
+    corpus_Append(buffer, "{\"created_at\":\"Sun Aug 31 00:%02lld:%02lld +0000 2014\",\"id\":%lld,\"id_str\":\"%lld\",\"text\":\"", index % 60, (index / 60) % 60, id, id);
+    corpus_AppendText(buffer, (int)corpus_Range(buffer, 4, 20));
+    corpus_Append(buffer, "\",\"truncated\":false,\"entities\":{\"hashtags\":[");
+    for(long long i = corpus_Range(buffer, 0, 3); i > 0; i--)
+    {
+        corpus_Append(buffer, "{\"text\":\"%s\",\"indices\":[%lld,%lld]}%s", corpus_Words[i], i * 10, i * 10 + 6, i > 1 ? "," : "");
+    }
+    
+    corpus_Append(buffer, "],\"urls\":[]},\"in_reply_to_status_id\":null,\"user\":{\"id\":%lld,\"name\":\"user %lld\",\"screen_name\":\"u%lld\",\"location\":\"", corpus_Range(buffer, 1, 1LL << 40), index, index);
+    corpus_AppendText(buffer, 2);
+    corpus_Append(buffer, "\",\"followers_count\":%lld,\"friends_count\":%lld,\"verified\":%s,\"profile_background_color\":\"C0DEED\",\"lang\":\"en\"},", corpus_Range(buffer, 0, 100000), corpus_Range(buffer, 0, 5000), corpus_Range(buffer, 0, 9) == 0 ? "true" : "false");
+    corpus_Append(buffer, "\"geo\":null,\"retweet_count\":%lld,\"favorite_count\":%lld,\"favorited\":false,\"retweeted\":false,\"lang\":\"en\"}", corpus_Range(buffer, 0, 500), corpus_Range(buffer, 0, 2000));
+}
+
+// a GeoJSON feature, almost all of it floating point coordinates
+static void corpus_GeoJson(corpusBuffer *buffer, long long index)
+{
+    corpus_Append(buffer, "{\"type\":\"Feature\",\"properties\":{\"name\":\"region %lld\",\"population\":%lld},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[", index, corpus_Range(buffer, 100, 10000000));
+    double lon = corpus_Uniform(buffer, -180.0, 180.0);
+    double lat = corpus_Uniform(buffer, -85.0, 85.0);
+    for(long long i = corpus_Range(buffer, 8, 64); i > 0; i--)
+    {
+        corpus_Append(buffer, "[%.13f,%.14f]%s", lon + corpus_Uniform(buffer, -0.5, 0.5), lat + corpus_Uniform(buffer, -0.5, 0.5), i > 1 ? "," : "");
+    }
+    
+    corpus_Append(buffer, "]]}}");
+}
+
+// containers nested a few hundred deep, which stresses the frame stack rather than the tokenizer
+static void corpus_Deep(corpusBuffer *buffer, long long index)
+{
+    long long depth = corpus_Range(buffer, 100, 400);
+    for(long long i = 0; i < depth; i++)
+    {
+        corpus_Append(buffer, (i + index) % 2 ? "{\"d\":" : "[");
+    }
+    
+    corpus_Append(buffer, "%lld", index);
+    for(long long i = depth - 1; i >= 0; i--)
+    {
+        corpus_Append(buffer, (i + index) % 2 ? "}" : "]");
+    }
+}
+
+// objects with hundreds of keys, where key lookups go through the per-object hash index
+static void corpus_Wide(corpusBuffer *buffer, long long index)
+{
+    corpus_Append(buffer, "{");
+    long long numKeys = corpus_Range(buffer, 100, 1000);
+    for(long long i = 0; i < numKeys; i++)
+    {
+        corpus_Append(buffer, "%s\"field_%lld_%lld\":%lld", i > 0 ? "," : "", index % 7, i, corpus_Range(buffer, -1000000, 1000000));
+    }
+    
+    corpus_Append(buffer, "}");
+}
+
+// strings full of escape sequences, including surrogate pairs
+static void corpus_Escapes(corpusBuffer *buffer, long long index)
+{
+    static const char *escapes[] = { "\\n", "\\t", "\\\"", "\\\\", "\\/", "\\u00e9", "\\u4e2d", "\\ud83d\\ude00", "\\r\\n" };
+    corpus_Append(buffer, "{\"id\":%lld,\"body\":\"", index);
+    for(long long i = corpus_Range(buffer, 10, 60); i > 0; i--)
+    {
+        corpus_AppendText(buffer, 1);
+        corpus_Append(buffer, "%s", escapes[corpus_Range(buffer, 0, sizeof(escapes) / sizeof(escapes[0]) - 1)]);
+    }
+    
+    corpus_Append(buffer, "\",\"path\":\"C:\\\\Users\\\\u%lld\\\\file.txt\"}", index);
+}
+
+// a log record, one per line
+static void corpus_Log(corpusBuffer *buffer, long long index)
+{
+    static const char *levels[] = { "debug", "info", "info", "info", "warn", "error" };
+    corpus_Append(buffer, "{\"ts\":%lld,\"level\":\"%s\",\"msg\":\"", 1400000000000LL + index * 13, levels[corpus_Range(buffer, 0, 5)]);
+    corpus_AppendText(buffer, (int)corpus_Range(buffer, 3, 12));
+    corpus_Append(buffer, "\",\"latency_ms\":%.3f,\"status\":%lld,\"tags\":[\"svc\",\"%s\"]}", corpus_Uniform(buffer, 0.0, 250.0), corpus_Range(buffer, 200, 504), corpus_Words[index % 16]);
+}
+
+static const corpusShape corpus_Shapes[] =
+{
+    { "twitter", "json", "{\"statuses\":[", ",", "],\"search_metadata\":{\"count\":100}}", corpus_Twitter },
+    { "geojson", "json", "{\"type\":\"FeatureCollection\",\"features\":[", ",", "]}", corpus_GeoJson },
+    { "deep", "json", "[", ",", "]", corpus_Deep },
+    { "wide", "json", "[", ",", "]", corpus_Wide },
+    { "escapes", "json", "[", ",", "]", corpus_Escapes },
+    { "log", "ndjson", "", "\n", "\n", corpus_Log },
+};
+
+static const corpusSize corpus_Sizes[] =
+{
+    { "64k", 64 * 1024 },
+    { "1m", 1024 * 1024 },
+    { "16m", 16 * 1024 * 1024 },
+};
+
+int main(int argc, const char *argv[])
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "usage: %s <directory>\n", argv[0]);
+        return 2;
+    }
+    
+    corpusBuffer buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    
+    for(size_t s = 0; s < sizeof(corpus_Shapes) / sizeof(corpus_Shapes[0]); s++)
+    {
+        for(size_t z = 0; z < sizeof(corpus_Sizes) / sizeof(corpus_Sizes[0]); z++)
+        {
+            const corpusShape *shape = corpus_Shapes + s;
+            buffer.Used = 0;
+            buffer.Seed = (uint64_t)(s + 1) * 1000003 + z;
+            
+            // whole records up to the target size, so every size is a valid document
+            corpus_Append(&buffer, "%s", shape->Begin);
+            for(long long i = 0; i == 0 || buffer.Used < corpus_Sizes[z].Bytes; i++)
+            {
+                if(i > 0)
+                {
+                    corpus_Append(&buffer, "%s", shape->Separator);
+                }
+                
+                shape->Record(&buffer, i);
+            }
+            
+            corpus_Append(&buffer, "%s", shape->End);
+            
+            char path[4096];
+            snprintf(path, sizeof(path), "%s/%s-%s.%s", argv[1], shape->Name, corpus_Sizes[z].Name, shape->Extension);
+            
+            FILE *file = fopen(path, "wb");
+            if(file == NULL || fwrite(buffer.Data, 1, buffer.Used, file) != buffer.Used || fclose(file) != 0)
+            {
+                fprintf(stderr, "corpus: cannot write %s\n", path);
+                return 1;
+            }
+            
+            printf("%s %zu\n", path, buffer.Used);
+        }
+    }
+    
+    free(buffer.Data);
+    return 0;
+}
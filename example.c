@@ -27,25 +27,36 @@ int main(int argc, const char * argv[])
         jasonValue *usersList = jason_HashLookup(&jason, jason.RootValue, "Users", strlen("Users"));
         if(usersList != NULL)
         {
+            // keys looked up for every user are hashed once
+            jasonKey keys[3];
+            jasonKey_Compile(&keys[0], "Name", strlen("Name"), NULL);
+            jasonKey_Compile(&keys[1], "Age", strlen("Age"), NULL);
+            jasonKey_Compile(&keys[2], "Salary", strlen("Salary"), NULL);
+            
             for(jasonValue *user = jasonValue_GetFirstChild(usersList); user != NULL; user = jasonValue_GetNextSibling(user))
             {
-                jasonValue *name = jason_HashLookup(&jason, user, "Name", strlen("Name"));
-                jasonValue *age = jason_HashLookup(&jason, user, "Age", strlen("Age"));
-                jasonValue *salary = jason_HashLookup(&jason, user, "Salary", strlen("Salary"));
+                jasonValue *values[3];
+                jason_LookupKeys(&jason, user, keys, 3, values);
+                
+                jasonValue *name = values[0];
+                jasonValue *age = values[1];
+                jasonValue *salary = values[2];
                 
                 if(name != NULL)
                 {
-                    printf("Name: %.*s\n", jasonValue_GetValueLen(name), jasonValue_GetValue(name));
+                    printf("Name: %.*s\n", (int)jasonValue_GetValueLen(name), jasonValue_GetValue(name));
                 }
                 
-                if(age != NULL)
+                int64_t ageValue;
+                if(age != NULL && jasonValue_GetInt64(age, &ageValue) == jasonStatus_Finished)
                 {
-                    printf("Age: %i\n", atoi(jasonValue_GetValue(age)));
+                    printf("Age: %lli\n", (long long)ageValue);
                 }
                 
-                if(salary != NULL)
+                double salaryValue;
+                if(salary != NULL && jasonValue_GetDouble(salary, &salaryValue) == jasonStatus_Finished)
                 {
-                    printf("Salary: %f\n", atof(jasonValue_GetValue(salary)));
+                    printf("Salary: %f\n", salaryValue);
                 }
             }
         }
@@ -14,9 +14,38 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <limits.h>
+#include <locale.h>
+#include <time.h>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(JASON_NO_MMAP)
+#define JASON_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef JASON_THREADS
+#include <pthread.h>
+#endif
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(JASON_NO_SIMD)
+#define JASON_X86_SIMD 1
+#include <immintrin.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
+#endif
+    
+    // lengths, offsets and tape indexes. Define JASON_64BIT for documents of 2GB and more, at the cost of a 24-byte jasonValue
+#ifdef JASON_64BIT
+    typedef int64_t jasonSize;
+#define JASON_SIZE_MAX INT64_MAX
+#else
+    typedef int32_t jasonSize;
+#define JASON_SIZE_MAX INT32_MAX
 #endif
     
     typedef void*(*jasonMallocCb_t)(size_t*);
@@ -33,6 +62,8 @@ extern "C" {
         jasonStatus_UnexpectedEndOfString = -3,
         jasonStatus_OutOfMemory = -4,
         jasonStatus_IntegerOverflow = -5,
+        jasonStatus_MaxDepthExceeded = -6,
+        jasonStatus_FileError = -7,
     }
     jasonStatus;
     
@@ -48,57 +79,742 @@ extern "C" {
     }
     jasonValueType;
     
+    typedef enum
+    {
+        jasonNumberType_Int64,
+        jasonNumberType_Uint64,
+        jasonNumberType_Double,
+        jasonNumberType_BigInteger // an integer outside the 64-bit range, approximated in Double
+    }
+    jasonNumberType;
+    
     typedef struct
     {
-        const char *Value;
         union
         {
-            int32_t ValueLen;	// only used by Values
-            int32_t Parent; // used by Keys only
+            int64_t Int64;
+            uint64_t Uint64;
+            double Double;
         };
         
-        int32_t Next;
+        jasonNumberType Type;
+    }
+    jasonNumber;
+    
+    typedef enum
+    {
+        jasonFlag_None = 0,
+        jasonFlag_StructuralIndex = 1 << 0, // run the stage-1 structural scan before building the tape
+        jasonFlag_PreCount = 1 << 1, // size the tape once up front from a quick count of separators
+        jasonFlag_DecodeNumbers = 1 << 2, // convert numbers while parsing into jason.Numbers, rejecting malformed ones
+        jasonFlag_HugePages = 1 << 3, // ask for transparent huge pages on files mapped by jason_DeserializeFile
+        jasonFlag_Lazy = 1 << 4, // parse one level, nested containers are expanded on first use through jason_GetFirstChild or a lookup
+        // Strict checks the containers Lazy passes over as well, but not the values a Projection passes over
+        jasonFlag_Strict = 1 << 5, // reject what RFC 8259 does not: loose numbers, trailing commas, bad escapes, control characters and invalid UTF-8
+    }
+    jasonFlag;
+    
+    typedef struct
+    {
+        const char *Value;
+        jasonSize ValueLen;
+        jasonSize Next; // next sibling, for object keys the next key
     }
     jasonValue;
     
+    // a 12-byte node that carries its own type, so walking the structure never touches the source text
+    typedef struct
+    {
+        uint32_t Offset; // from jasonCompactTape.Source to the first character of the value
+        uint32_t Info; // type in the top 3 bits, then the escape flag, then the length or child count
+        int32_t Next;
+    }
+    jasonCompactValue;
+    
+    typedef struct
+    {
+        const char *Source;
+        jasonCompactValue *Nodes; // in the same order as jason.RootValue
+        int32_t NumNodes;
+    }
+    jasonCompactTape;
+    
+    typedef struct
+    {
+        jasonSize Object; // tape index of the object
+        int32_t Capacity; // slots, a power of two no smaller than 16, 0 marks an unused directory entry
+        int32_t Sorted; // probing ran past JASON_MAX_PROBE_GROUPS, the key offsets are sorted by key instead
+        size_t Offset; // control bytes followed by key offsets, within jasonHashTable.Slots
+    }
+    jasonObjectIndex;
+    
     typedef struct
     {
-        int32_t *Buckets;
-        int32_t NumBuckets;
-        int32_t NumKeys;
+        jasonObjectIndex *Directory; // open addressed on the object's tape index, only objects with more than JASON_LINEAR_SCAN_KEYS keys
+        int32_t DirectorySize;
+        int32_t NumIndexed;
+        uint8_t *Slots;
+        size_t SlotsUsed;
+        size_t SlotsSize;
     }
     jasonHashTable;
     
+    typedef struct
+    {
+        const char *Key;
+        int32_t KeyLen;
+        uint32_t Hash;
+        jasonHashCb_t HashFn; // the hash the handle was compiled with, documents using another one rehash the key
+        uint64_t Seed; // and with jason_Hash, the seed
+    }
+    jasonKey;
+    
+    typedef struct
+    {
+        jasonKey Key;
+        int32_t Index; // array position when the segment is a plain non-negative integer, -1 otherwise
+    }
+    jasonPathSegment;
+    
+    typedef struct
+    {
+        jasonPathSegment *Segments;
+        int32_t NumSegments;
+    }
+    jasonPath;
+    
+    typedef struct
+    {
+        size_t KeyOffset; // within jasonProjection.Text
+        int32_t KeyLen;
+        int32_t Index; // as in jasonPathSegment
+        int32_t Wildcard; // "*", any key or element
+        int32_t FirstChild; // -1 for none
+        int32_t NextSibling;
+        int32_t KeepAll; // a path ends here, everything below is kept
+    }
+    jasonProjectionNode;
+    
+    // paths to keep while parsing, merged into a trie. Node 0 is the root of the document
+    typedef struct
+    {
+        jasonProjectionNode *Nodes;
+        int32_t NumNodes;
+        int32_t NodesSize;
+        char *Text;
+        size_t TextUsed;
+        size_t TextSize;
+    }
+    jasonProjection;
+    
+    typedef enum
+    {
+        jasonIndexFlag_None = 0,
+        jasonIndexFlag_Sorted = 1 << 0 // also keep the numeric values in order, for jason_IndexRange
+    }
+    jasonIndexFlag;
+    
+    typedef enum
+    {
+        jasonIndexKeyKind_None,
+        jasonIndexKeyKind_Int64, // integers up to INT64_MAX, however they were written
+        jasonIndexKeyKind_Uint64, // integers past INT64_MAX
+        jasonIndexKeyKind_Double, // other numbers a double holds exactly
+        jasonIndexKeyKind_String,
+        jasonIndexKeyKind_Decimal // every other number, by its digits
+    }
+    jasonIndexKeyKind;
+    
+    // what jason_BuildIndex files an element under: a string's text as written, or a number by its value
+    typedef struct
+    {
+        const char *Text; // strings, and numbers keyed by their digits
+        jasonSize TextLen;
+        uint64_t Bits; // numbers only, the integer or the bits of the double, the nearest one for a decimal
+        jasonIndexKeyKind Kind;
+        uint32_t Hash;
+    }
+    jasonIndexKey;
+    
+    // a number as written, read as the digits of its value between the first and last that are not zero, times a power
+    // of ten. Every way of writing one value reads the same, so digests and jason_Equal compare numbers exactly
+    typedef struct
+    {
+        const char *Digits; // may have the decimal point of the text among them
+        const char *DigitsEnd;
+        jasonSize NumDigits; // 0 for zero
+        int64_t Exponent;
+        int32_t Negative;
+    }
+    jasonDecimal;
+    
+    // the elements filed under one key
+    typedef struct
+    {
+        jasonIndexKey Key;
+        jasonSize First; // within jasonValueIndex.Elements
+        jasonSize Count; // 0 for an unused slot
+    }
+    jasonIndexSlot;
+    
+    typedef struct jasonValueIndex jasonValueIndex;
+    
+    // callbacks for jason_DeserializeSax return jasonStatus_Continue to go on, jasonStatus_Finished to stop the parse there
+    // or an error status to abort it with
+    typedef jasonStatus(*jasonSaxCb_t)(void *context);
+    
+    // the value is a node on the parser's stack, for use with the jasonValue accessors until the callback returns
+    typedef jasonStatus(*jasonSaxValueCb_t)(void *context, jasonValue *value);
+    typedef jasonStatus(*jasonSaxNumberCb_t)(void *context, jasonValue *value, const jasonNumber *number);
+    
+    // events raised by jason_DeserializeSax, any of the callbacks may be NULL
+    typedef struct
+    {
+        jasonSaxCb_t StartObject;
+        jasonSaxCb_t EndObject;
+        jasonSaxCb_t StartArray;
+        jasonSaxCb_t EndArray;
+        jasonSaxValueCb_t Key;
+        jasonSaxValueCb_t String;
+        jasonSaxNumberCb_t Number; // number is only decoded with jasonFlag_DecodeNumbers, NULL otherwise
+        jasonSaxValueCb_t Bool;
+        jasonSaxValueCb_t Null;
+        void *Context;
+        uint32_t Flags; // of the jasonFlag values only DecodeNumbers and Strict apply
+        int32_t MaxDepth; // 0 for JASON_DEFAULT_MAX_DEPTH, which is also the most allowed
+        const char *Position; // on return, just past the last value handled or at the error
+    }
+    jasonSaxHandler;
+    
+    typedef struct
+    {
+        uint64_t Quote;
+        uint64_t Backslash;
+        uint64_t Whitespace;
+        uint64_t Structural;
+    }
+    jasonBlockMasks;
+    
+    typedef void(*jasonClassifyBlockCb_t)(const char*, jasonBlockMasks*);
+    typedef int32_t(*jasonCheckStringCb_t)(const char*, jasonSize);
+    
+    typedef struct
+    {
+        const char *Source;
+        jasonSize *Positions; // offsets of structural characters, quotes and atom starts, terminated by the input length
+        jasonSize NumPositions;
+        jasonSize Cursor;
+    }
+    jasonStructuralIndex;
+    
+    typedef enum
+    {
+        jasonParseState_Value,
+        jasonParseState_String,
+        jasonParseState_Literal,
+        jasonParseState_Number,
+        jasonParseState_KeySeparator,
+        jasonParseState_ValueSeparator,
+        jasonParseState_Skip, // in a value a projection passes over, fed in chunks
+        jasonParseState_Done
+    }
+    jasonParseState;
+    
+    // how far jason_SkipContainerFrom got through a container, kept between chunks
+    typedef struct
+    {
+        jasonSize Depth;
+        uint64_t PrevEscaped;
+        uint64_t PrevInString;
+    }
+    jasonSkipState;
+    
+    typedef struct jasonSourceBlock
+    {
+        struct jasonSourceBlock *Prev;
+        size_t Size;
+        size_t Used;
+    }
+    jasonSourceBlock; // fed input or arena memory follows the header
+    
+    // a bump allocator over chained blocks, everything it hands out is released at once
+    typedef struct
+    {
+        jasonMallocCb_t Malloc; // jason_Malloc and jason_Free when not set
+        jasonFreeCb_t Free;
+        jasonSourceBlock *Blocks; // newest first
+        size_t BlockSize; // 0 for JASON_ARENA_BLOCK_SIZE
+    }
+    jasonArena;
+    
+    typedef struct jasonExpansion jasonExpansion;
+    
+#ifdef JASON_STATS
+    typedef enum
+    {
+        jasonStage_PreCount,
+        jasonStage_StructuralIndex,
+        jasonStage_Parse,
+        jasonStage_Count
+    }
+    jasonStage;
+    
+    typedef void(*jasonStageCb_t)(void *context, jasonStage stage);
+    
+    // counters filled in by a document while JASON_STATS is defined, they keep adding up until the caller clears them
+    typedef struct
+    {
+        uint64_t TapeResizes; // the tape outgrew its allocation and was moved
+        uint64_t BufferGrowths; // decoded numbers, index slots and other buffers that had to double
+        uint64_t SourceBlocks; // blocks allocated by jason_Feed
+        uint64_t CarriedBytes; // unfinished tokens copied into a new block by jason_Feed
+        uint64_t ObjectsIndexed; // objects large enough to get a key hash index
+        uint64_t IndexedKeys;
+        uint64_t DirectoryGrowths; // rehashes of the directory of object indexes
+        uint64_t IndexedLookups;
+        uint64_t ScannedLookups; // lookups in objects too small for an index
+        uint64_t ProbedGroups; // 16-slot groups visited by indexed lookups
+        uint64_t LongestProbe; // the most groups a single lookup visited
+        uint64_t SortedIndexes; // objects whose keys collided past JASON_MAX_PROBE_GROUPS
+        uint64_t NumValues[jasonValueType_Null + 1]; // by jasonValueType
+        uint64_t ValueBytes[jasonValueType_Null + 1]; // the value's own text: quotes included, a container counts its brackets only
+        uint64_t StageNanoseconds[jasonStage_Count];
+        uint64_t StageStart[jasonStage_Count];
+        jasonStageCb_t OnStageBegin; // optional, called around every stage
+        jasonStageCb_t OnStageEnd;
+        void *HookContext;
+    }
+    jasonStats;
+#endif
+    
+    typedef struct
+    {
+        jasonSize Container; // tape index of the open object or array
+        jasonSize Last; // tape index of its last value, 0 if none yet
+        jasonSize LastKey; // same for keys of an object
+        jasonSize NumChildren;
+        jasonSize Skipped; // values passed over by a projection
+        int32_t Projection; // projection node of the container, -1 when all of it is kept
+        int32_t Pending; // projection node of the value being parsed
+        int32_t Separated; // a comma has come since the opening bracket, so a closing one in place of a value trails it
+    }
+    jasonFrame;
+    
     typedef struct
     {
         jasonHashTable KeyLookupTable;
+        jasonStructuralIndex StructuralIndex;
         jasonMallocCb_t Malloc;
         jasonFreeCb_t Free;
+        jasonReallocCb_t Realloc; // optional, tape growth falls back to Malloc and copy
         jasonHashCb_t Hash;
+        uint64_t HashSeed; // used by jason_Hash in place of the process seed, set by jason_Begin when 0
         jasonValue *RootValue;
         const char *ParsePosition;
-        int32_t NumValues;
-        int32_t MaxValues;
+        jasonSize NumValues;
+        jasonSize MaxValues;
+        jasonSize ExpectedValues; // size hint for the initial tape
+        uint32_t Flags;
+        jasonFrame *Stack; // may be supplied by the caller, allocated on demand otherwise
+        int32_t StackSize;
+        int32_t Depth;
+        int32_t MaxDepth; // 0 for JASON_DEFAULT_MAX_DEPTH
+        int32_t OwnsStack;
+        jasonParseState ParseState;
+        jasonSkipState Skip; // with jasonParseState_Skip
+        jasonSourceBlock *SourceBlocks; // input handed to jason_Feed
+        jasonNumber *Numbers; // with jasonFlag_DecodeNumbers, indexed like the tape
+        size_t NumbersSize;
+        void *File; // contents of the file given to jason_DeserializeFile
+        size_t FileSize;
+        int32_t FileMapped; // File is a mapping rather than a Malloc buffer
+        const jasonProjection *Projection; // optional, jason_Deserialize and jason_Feed keep only the values it leads to
+        jasonExpansion **Expansions; // containers expanded with jasonFlag_Lazy, open addressed on the container's address
+        int32_t ExpansionsSize;
+        int32_t NumExpansions;
+        jasonValueIndex *Indexes; // built by jason_BuildIndex, newest first
+        uint64_t *Digests; // filled by jason_ComputeDigests, indexed like the tape
+        size_t DigestsSize;
+        jasonSize NumDigests; // values with a digest, 0 until jason_ComputeDigests runs
+#ifdef JASON_STATS
+        jasonStats *Stats; // optional, not handed on to the documents parsed on other threads
+#endif
     }
     jason;
     
-#define JASON_INCSTR(pointer, end) pointer++; if(pointer >= end) { return jasonStatus_UnexpectedEndOfString; }
-#define JASON_INCVAL(pointer, end) { pointer++; if(pointer >= end) { return jasonStatus_OutOfMemory; } }
+    // a document kept for parse after parse. Its tape, key index and stack are reused, and so is the arena that decoded
+    // data is copied into, until they grow past MaxRetainedBytes
+    typedef struct
+    {
+        jason Document;
+        jasonArena Arena;
+        size_t MaxRetainedBytes; // kept by jasonContext_Reset for each of the two, 0 for JASON_CONTEXT_MAX_RETAINED
+    }
+    jasonContext;
+    
+    // the start of a file written by jason_SaveFile. The sections follow at multiples of JASON_SAVED_ALIGN, and the tape
+    // holds offsets into the source section in place of pointers, so the file loads at any address
+    typedef struct
+    {
+        char Magic[8]; // JASON_SAVED_MAGIC, without its terminator
+        uint32_t Version; // JASON_SAVED_VERSION
+        uint32_t ByteOrder; // 0x01020304 as the writer stored it
+        uint32_t Layout; // JASON_SAVED_LAYOUT of the writer
+        uint32_t Flags; // jasonFlag values the document was parsed with
+        uint64_t Checksum; // of everything after the header, JASON_SAVED_CHUNK bytes at a time
+        uint64_t HashSeed; // the key index was built with
+        uint32_t DefaultHash; // the key index was built with jason_Hash rather than a caller's function
+        int32_t DirectorySize;
+        int32_t NumIndexed;
+        uint32_t Reserved;
+        uint64_t FileSize;
+        uint64_t SourceOffset;
+        uint64_t SourceSize;
+        uint64_t TapeOffset;
+        uint64_t NumValues;
+        uint64_t DirectoryOffset;
+        uint64_t SlotsOffset;
+        uint64_t SlotsSize;
+        uint64_t NumbersOffset; // 0 when the document has no decoded numbers
+    }
+    jasonSavedHeader;
+    
+    typedef struct
+    {
+        FILE *File;
+        char *Buffer; // JASON_SAVED_CHUNK bytes, checksummed as each one is written out
+        size_t Used;
+        uint64_t Offset; // of the next byte in the file
+        uint64_t Checksum;
+        jasonStatus Status; // the first error
+    }
+    jasonSaver;
+    
+    typedef struct
+    {
+        char *Base;
+        size_t Len; // on return from jasonWriter_Finish, the bytes written into this buffer
+    }
+    jasonIoVec;
+    
+    typedef enum
+    {
+        jasonWriterFlag_None = 0,
+        jasonWriterFlag_Pretty = 1 << 0 // newlines and indentation between values
+    }
+    jasonWriterFlag;
+    
+    typedef struct
+    {
+        jasonSize Remaining; // children of the container still to be written
+        int32_t IsObject;
+        int32_t NextIsKey;
+    }
+    jasonWriterFrame;
+    
+    typedef struct
+    {
+        jasonMallocCb_t Malloc;
+        jasonFreeCb_t Free;
+        jasonReallocCb_t Realloc;
+        char *Buffer; // output, unless IoVecs is set
+        size_t Size;
+        size_t Used;
+        jasonIoVec *IoVecs; // optional caller buffers, filled in order
+        int32_t NumIoVecs;
+        int32_t IoVecIndex;
+        size_t IoVecUsed;
+        uint32_t Flags;
+        int32_t Indent; // spaces per level with jasonWriterFlag_Pretty, 0 for JASON_DEFAULT_INDENT
+        int32_t Depth;
+        int32_t First; // nothing written yet in the innermost open container
+        int32_t AfterKey;
+        jasonStatus Status; // the first error, every later call returns it
+        jasonWriterFrame *Stack; // used by jasonWriter_WriteValue
+        int32_t StackSize;
+    }
+    jasonWriter;
+    
+    typedef struct jasonNode jasonNode;
+    
+    // a value of a jasonDocument. Value holds its JSON text the way the tape does, so the jasonValue accessors work on
+    // scalars. A container's Value is only its opening bracket, its members are reached through First and Next
+    struct jasonNode
+    {
+        jasonValue Value;
+        jasonValue Key; // when the parent is an object, the member's key with its quotes
+        uint32_t KeyHash;
+        jasonNode *Parent;
+        jasonNode *First;
+        jasonNode *Last;
+        jasonNode *Prev;
+        jasonNode *Next;
+        jasonSize NumChildren; // members of an object or elements of an array
+        jasonNode **Index; // objects with more than JASON_LINEAR_SCAN_KEYS members, open addressed on KeyHash
+        int32_t IndexSize;
+        int32_t IndexUsed; // members and the slots of removed ones
+    };
+    
+    // a mutable tree of jasonNodes. Nodes, their text and the object indexes live in the arena, so nothing is freed until
+    // jasonDocument_Free, removed nodes included
+    typedef struct
+    {
+        jasonArena Arena;
+        jasonHashCb_t Hash; // jason_Hash when not set
+    }
+    jasonDocument;
+    
+    typedef struct
+    {
+        jasonValue *Root; // the line's tape, NULL when it failed to parse
+        jasonSize NumValues;
+        jasonSize Offset; // of the line within the batch text
+        jasonStatus Status;
+    }
+    jasonLine;
+    
+    // called from the worker threads, in line order within each worker only. The document is reused for the next line
+    typedef void(*jasonLineCb_t)(void *context, const char *line, jasonSize lineLen, jason *document, jasonStatus status);
+    
+    // the children of a container skipped by jasonFlag_Lazy, parsed into a document of their own
+    struct jasonExpansion
+    {
+        jasonValue *Container;
+        jason Document;
+    };
+    
+    // the elements of an array by the string or number at a path within each one, built by jason_BuildIndex. It belongs to
+    // the document it was built on and is freed by jason_Reset and jason_Cleanup
+    struct jasonValueIndex
+    {
+        jasonValueIndex *Next; // the document's other indexes
+        jason *Document; // holding the elements and the index, an expansion when the array was skipped by jasonFlag_Lazy
+        jasonValue *Array;
+        jasonIndexSlot *Slots; // open addressed on the key's hash
+        jasonSize Capacity; // slots, a power of two at least twice the number of elements
+        jasonSize NumKeys;
+        jasonValue **Elements; // grouped by key, each group in array order
+        jasonSize NumElements; // elements with a string or number at the path, the others are left out
+        jasonValue **Sorted; // with jasonIndexFlag_Sorted, the elements with a number at the path in numeric order
+        double *SortedNumbers; // and those numbers
+        jasonSize NumSorted;
+    };
+    
+    typedef enum
+    {
+        jasonDiffKind_Changed, // a different value or one of another type at the path
+        jasonDiffKind_Added, // only in the new document
+        jasonDiffKind_Removed // only in the old one
+    }
+    jasonDiffKind;
+    
+    // called by jason_Diff for each difference, with the JSON Pointer to it built from keys as they are written. Before
+    // is NULL for an added value and after for a removed one. Returns like the jasonSaxHandler callbacks
+    typedef jasonStatus(*jasonDiffCb_t)(void *context, jasonDiffKind kind, const char *path, size_t pathLen, jasonValue *before, jasonValue *after);
+    
+    typedef struct
+    {
+        jasonDiffCb_t Callback;
+        void *Context;
+        jason *Allocator; // of Path, the old document
+        char *Path; // of the values being compared
+        size_t PathLen;
+        size_t PathSize;
+    }
+    jasonDiff;
+    
+    typedef struct jasonBatch jasonBatch;
+    
+    typedef struct
+    {
+        jasonBatch *Batch;
+        const char *Begin; // this worker's share of the text, whole lines only
+        const char *End;
+        jason Document; // reused for every line, so its tape and key index memory is allocated once
+        jasonValue *Tape; // tapes of the parsed lines, one after another
+        size_t TapeSize;
+        jasonSize TapeUsed;
+        jasonLine *Lines;
+        size_t LinesSize;
+        jasonSize NumLines;
+        jasonStatus Status;
+    }
+    jasonBatchWorker;
+    
+    struct jasonBatch
+    {
+        jasonMallocCb_t Malloc;
+        jasonFreeCb_t Free;
+        jasonReallocCb_t Realloc;
+        uint32_t Flags; // jasonFlag values for every line, Lazy only applies with a Callback
+        int32_t NumThreads; // 0 for one, ignored without JASON_THREADS
+        jasonLineCb_t Callback; // optional, Lines is left empty when set
+        void *Context;
+        jasonLine *Lines; // every non-blank line in order
+        jasonSize NumLines;
+        size_t LinesSize;
+        jasonBatchWorker *Workers; // kept between batches along with their memory
+        int32_t NumWorkers;
+    };
+    
+    typedef struct
+    {
+        jasonSize DepthChange; // brackets opened minus brackets closed
+        jasonSize MinCommaDepth; // lowest depth of a comma relative to the segment start
+        const char *FirstMinComma; // first comma at that depth
+    }
+    jasonSegmentBrackets;
+    
+    typedef struct
+    {
+        const char *Begin; // bytes classified by this segment, never straight after a backslash
+        const char *End;
+        jasonSegmentBrackets Brackets[2]; // for the segment starting outside a string, and inside one
+        int32_t QuoteParity; // the segment flips the in-string state
+        const char *RootBracket; // the '[' of the document, stands in for the root in later pieces
+        const char *PieceBegin; // elements of the root array parsed by this segment
+        const char *PieceEnd;
+        int32_t IsFirst;
+        int32_t IsLast;
+        jason Document;
+        jasonStatus Status;
+    }
+    jasonSegment;
+    
+#ifndef JASON_DEFAULT_MAX_DEPTH
+#define JASON_DEFAULT_MAX_DEPTH 4096
+#endif
+    
+#ifndef JASON_DEFAULT_INDENT
+#define JASON_DEFAULT_INDENT 2
+#endif
+    
+#ifndef JASON_BATCH_MIN_BYTES
+#define JASON_BATCH_MIN_BYTES (64 * 1024)
+#endif
+    
+#ifndef JASON_PARALLEL_MIN_BYTES
+#define JASON_PARALLEL_MIN_BYTES (1024 * 1024)
+#endif
+    
+#ifndef JASON_MAX_THREADS
+#define JASON_MAX_THREADS 256
+#endif
+    
+#define JASON_SAX_STACK_WORDS ((JASON_DEFAULT_MAX_DEPTH + 63) / 64)
+    
+#ifndef JASON_SOURCEBLOCK_SIZE
+#define JASON_SOURCEBLOCK_SIZE (64 * 1024)
+#endif
+    
+#ifndef JASON_CONTEXT_MAX_RETAINED
+#define JASON_CONTEXT_MAX_RETAINED (4 * 1024 * 1024)
+#endif
+    
+#ifndef JASON_CONTEXT_POOL_SIZE
+#define JASON_CONTEXT_POOL_SIZE 8
+#endif
+    
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define JASON_THREAD_LOCAL _Thread_local
+#elif defined(_MSC_VER)
+#define JASON_THREAD_LOCAL __declspec(thread)
+#else
+#define JASON_THREAD_LOCAL __thread
+#endif
+    
+    // for what is chosen once on first use, when several threads can get there at the same time. Without the GCC
+    // builtins these are plain loads and stores
+#if defined(__GNUC__) || defined(__clang__)
+#define JASON_ATOMIC_LOAD(at) __atomic_load_n((at), __ATOMIC_ACQUIRE)
+#define JASON_ATOMIC_STORE(at, value) __atomic_store_n((at), (value), __ATOMIC_RELEASE)
+#define JASON_ATOMIC_SET_FROM(at, expected, value) __atomic_compare_exchange_n((at), (expected), (value), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+#define JASON_ATOMIC_LOAD(at) (*(at))
+#define JASON_ATOMIC_STORE(at, value) (*(at) = (value))
+#define JASON_ATOMIC_SET_FROM(at, expected, value) ((*(at) == *(expected)) ? (*(at) = (value), 1) : (*(expected) = *(at), 0))
+#endif
+    
+#define JASON_SAVED_MAGIC "JASONTAP"
+#define JASON_SAVED_VERSION 1
+#define JASON_SAVED_ALIGN 64
+#define JASON_SAVED_CHUNK (64 * 1024)
+#define JASON_SAVED_BODY ((sizeof(jasonSavedHeader) + JASON_SAVED_ALIGN - 1) / JASON_SAVED_ALIGN * JASON_SAVED_ALIGN)
+#define JASON_SAVED_LAYOUT ((uint32_t)(sizeof(jasonValue) | sizeof(jasonObjectIndex) << 8 | sizeof(jasonNumber) << 16 | sizeof(jasonSize) << 24))
+#define JASON_SAVED_CHECKSUM_SEED 0x6a61736f6e746170ull
+
+#ifndef JASON_ARENA_BLOCK_SIZE
+#define JASON_ARENA_BLOCK_SIZE (64 * 1024)
+#endif
+    
+#define JASON_SOURCEBLOCK_DATA(block) ((char*)((block) + 1))
+#ifndef JASON_LINEAR_SCAN_KEYS
+#define JASON_LINEAR_SCAN_KEYS 8
+#endif
+    
+#ifndef JASON_MAX_PROBE_GROUPS
+#define JASON_MAX_PROBE_GROUPS 8
+#endif
+    
+#define JASON_SLOT_EMPTY 0x80
+#define JASON_STRING_ESCAPED ((jasonSize)1 << (sizeof(jasonSize) * 8 - 2)) // set in a string's ValueLen when it contains backslash escapes
+#define JASON_VALUELEN_MASK (JASON_STRING_ESCAPED - 1)
+#define JASON_COMPACT_TYPE_SHIFT 29
+#define JASON_COMPACT_ESCAPED (1u << 28)
+#define JASON_COMPACT_LEN_MASK 0x0FFFFFFF
+#define JASON_ISDIGIT(c) ((unsigned char)((c) - '0') < 10)
+#define JASON_ISWHITESPACE(c) ((c) == ' ' || (c) == '\n' || (c) == '\t' || (c) == '\r')
 #define JASON_SKIPWHITESPACE(pointer, end) \
-while(pointer < end && (*pointer == ' ' || *pointer == '\n' || *pointer == '\t' || *pointer == '\r')) \
+while(pointer < end && JASON_ISWHITESPACE(*pointer)) \
     { \
         pointer++; \
     }
     
+#define JASON_SKIPTOTOKEN(jason, pointer, end) \
+    { \
+        if(jason->StructuralIndex.Positions != NULL) \
+        { \
+            if(pointer < end && JASON_ISWHITESPACE(*pointer)) \
+            { \
+                pointer = jason_NextStructural(jason, pointer); \
+            } \
+        } \
+        else \
+        { \
+            JASON_SKIPWHITESPACE(pointer, end); \
+        } \
+    }
+    
+#ifdef JASON_STATS
+#ifndef JASON_STATS_NOW
+#define JASON_STATS_NOW() jason_StatsNow()
+#endif
+#define JASON_STATS_ADD(jason, counter, amount) \
+    { \
+        if((jason)->Stats != NULL) \
+        { \
+            (jason)->Stats->counter += (amount); \
+        } \
+    }
+#define JASON_STATS_STAGE(jason, stage, isEnd) jason_StatsStage(jason, stage, isEnd)
+#define JASON_STATS_VALUE(jason, value) jason_StatsValue(jason, value)
+#define JASON_STATS_PROBE(jason, groups) jason_StatsProbe(jason, groups)
+#else
+#define JASON_STATS_ADD(jason, counter, amount)
+#define JASON_STATS_STAGE(jason, stage, isEnd)
+#define JASON_STATS_VALUE(jason, value)
+#define JASON_STATS_PROBE(jason, groups)
+#endif
+    
 #define JASON_SETOFFSET(dest, len) \
     { \
-        if(len >= INT_MAX || len <= INT_MIN) \
+        if(len >= JASON_SIZE_MAX || len <= -JASON_SIZE_MAX) \
         { \
             return jasonStatus_Break(jasonStatus_IntegerOverflow); \
         } \
         else \
         { \
-            dest = (int32_t)(len); \
+            dest = (jasonSize)(len); \
         } \
     }
     
@@ -115,6 +831,8 @@ while(pointer < end && (*pointer == ' ' || *pointer == '\n' || *pointer == '\t'
                 JASON_STRINGIFY_CASE(jasonStatus_ExpectedObjectKey);
                 JASON_STRINGIFY_CASE(jasonStatus_UnexpectedCharacter);
                 JASON_STRINGIFY_CASE(jasonStatus_UnexpectedEndOfString);
+                JASON_STRINGIFY_CASE(jasonStatus_MaxDepthExceeded);
+                JASON_STRINGIFY_CASE(jasonStatus_FileError);
         }
         
         return "";
@@ -181,14 +899,14 @@ while(pointer < end && (*pointer == ' ' || *pointer == '\n' || *pointer == '\t'
         }
     }
     
-    int32_t jasonValue_GetValueLen(jasonValue *value)
+    jasonSize jasonValue_GetValueLen(jasonValue *value)
     {
         jasonValueType type = jasonValue_GetType(value);
         
         switch(type)
         {
             case jasonValueType_String:
-                return value->ValueLen - 2;
+                return (value->ValueLen & JASON_VALUELEN_MASK) - 2;
                 
             case jasonValueType_Object:
             case jasonValueType_Array:
@@ -199,10 +917,24 @@ while(pointer < end && (*pointer == ' ' || *pointer == '\n' || *pointer == '\t'
         }
     }
     
+    // a string without escapes can be used directly through jasonValue_GetValue/GetValueLen
+    int32_t jasonValue_HasEscapes(jasonValue *value)
+    {
+        return jasonValue_GetType(value) == jasonValueType_String && (value->ValueLen & JASON_STRING_ESCAPED) != 0;
+    }
+    
+    // a container passed over by jasonFlag_Lazy, its ValueLen is minus its length in bytes and it has no children on the
+    // tape until it is expanded
+    int32_t jasonValue_IsLazy(jasonValue *value)
+    {
+        jasonValueType type = jasonValue_GetType(value);
+        return (type == jasonValueType_Object || type == jasonValueType_Array) && value->ValueLen < 0;
+    }
+    
     jasonValue *jasonValue_GetFirstChild(jasonValue *parent)
     {
         jasonValueType type = jasonValue_GetType(parent);
-        if((type == jasonValueType_Object || type == jasonValueType_Array) && parent->ValueLen > 1)
+        if((type == jasonValueType_Object || type == jasonValueType_Array) && parent->ValueLen > 0)
         {
             return parent + 1;
         }
@@ -220,497 +952,8195 @@ while(pointer < end && (*pointer == ' ' || *pointer == '\n' || *pointer == '\t'
         return NULL;
     }
     
-    uint32_t jason_HashKey(jason *jason, jasonValue *parent, const char *key, int32_t keyLen)
+    jasonValueType jasonCompactValue_GetType(jasonCompactValue *value)
     {
-        uint32_t parentHash = jason->Hash((char*)parent->Value, sizeof(intptr_t));
-        uint32_t keyHash = jason->Hash((char*)key, keyLen);
-        parentHash ^= keyHash + 0x9e3779b9 + (parentHash << 6) + (parentHash >> 2);
-        
-        return parentHash;
+        return (jasonValueType)(value->Info >> JASON_COMPACT_TYPE_SHIFT);
     }
     
-    jasonStatus jason_HashInsertDirect(jason *jason, jasonHashTable *table, jasonValue *val, uint32_t hash)
+    const char *jasonCompactValue_GetValue(jasonCompactTape *tape, jasonCompactValue *value)
     {
-        table->NumKeys++;
-        uint32_t bucketIndex = hash % table->NumBuckets;
-        int32_t keyIndex = table->Buckets[bucketIndex];
-        if(keyIndex != 0)
+        return tape->Source + value->Offset;
+    }
+    
+    // like jasonValue_GetValueLen, strings without their quotes and 1 for containers
+    int32_t jasonCompactValue_GetValueLen(jasonCompactValue *value)
+    {
+        jasonValueType type = jasonCompactValue_GetType(value);
+        if(type == jasonValueType_Object || type == jasonValueType_Array)
         {
-            jasonValue *key = jason->RootValue + keyIndex;
-            JASON_SETOFFSET(val->Next, (key - val));
+            return 1;
         }
         
-        JASON_SETOFFSET(table->Buckets[bucketIndex], (val - jason->RootValue));
-        
-        return jasonStatus_Continue;
+        return (int32_t)(value->Info & JASON_COMPACT_LEN_MASK);
     }
     
-    jasonStatus jason_HashInsert(jason *jason, jasonValue *val, jasonValue *parent, const char *keyStr, int32_t keyLen)
+    // values directly inside a container, keys included
+    int32_t jasonCompactValue_GetNumChildren(jasonCompactValue *value)
     {
-        val->Next = 0;
-        JASON_SETOFFSET(val->Parent, (parent - val));
-        
-        if(jason->KeyLookupTable.NumBuckets <= jason->KeyLookupTable.NumKeys)
+        jasonValueType type = jasonCompactValue_GetType(value);
+        if(type == jasonValueType_Object || type == jasonValueType_Array)
         {
-            jasonHashTable newTable;
-            memset(&newTable, 0, sizeof(jasonHashTable));
-
-            size_t memLength = (jason->KeyLookupTable.NumKeys + 32) * sizeof(int32_t);
-            newTable.Buckets = jason->Malloc(&memLength);
-            newTable.NumBuckets = (int32_t)(memLength / (sizeof(int32_t)));
-            
-            if(newTable.NumBuckets == 0)
-            {
-                return jasonStatus_Break(jasonStatus_OutOfMemory);
-            }
-            
-            memset(newTable.Buckets, 0, memLength);
-            
-            if(jason->KeyLookupTable.Buckets)
+            return (int32_t)(value->Info & JASON_COMPACT_LEN_MASK);
+        }
+        
+        return 0;
+    }
+    
+    int32_t jasonCompactValue_HasEscapes(jasonCompactValue *value)
+    {
+        return (value->Info & JASON_COMPACT_ESCAPED) != 0;
+    }
+    
+    jasonCompactValue *jasonCompactValue_GetFirstChild(jasonCompactValue *parent)
+    {
+        if(jasonCompactValue_GetNumChildren(parent) > 0)
+        {
+            return parent + 1;
+        }
+        
+        return NULL;
+    }
+    
+    jasonCompactValue *jasonCompactValue_GetNextSibling(jasonCompactValue *value)
+    {
+        if(value->Next != 0)
+        {
+            return value + value->Next;
+        }
+        
+        return NULL;
+    }
+    
+    void jason_ClassifyBlock_Scalar(const char *block, jasonBlockMasks *masks)
+    {
+        memset(masks, 0, sizeof(jasonBlockMasks));
+        
+        for(int i = 0; i < 64; i++)
+        {
+            uint64_t bit = (uint64_t)1 << i;
+            switch(block[i])
             {
-                for(size_t i = 0; i < jason->KeyLookupTable.NumBuckets; i++)
-                {
-                    while(jason->KeyLookupTable.Buckets[i] != 0)
-                    {
-                        jasonValue *key = jason->RootValue + jason->KeyLookupTable.Buckets[i];
-                        jason->KeyLookupTable.Buckets[i] = key->Next;
-                        // re-insert
-                        
-                        uint32_t hash = jason_HashKey(jason, key + key->Parent, jasonValue_GetValue(key), jasonValue_GetValueLen(key));
-                        jasonStatus status = jason_HashInsertDirect(jason, &newTable, key, hash);
-                        if(status != jasonStatus_Continue)
-                        {
-                            return status;
-                        }
-                    }
-                }
+                case '"':
+                    masks->Quote |= bit;
+                    break;
+                    
+                case '\\':
+                    masks->Backslash |= bit;
+                    break;
+                    
+                case ' ':
+                case '\n':
+                case '\t':
+                case '\r':
+                    masks->Whitespace |= bit;
+                    break;
+                    
+                case '{':
+                case '}':
+                case '[':
+                case ']':
+                case ':':
+                case ',':
+                    masks->Structural |= bit;
+                    break;
             }
-            
-            jason->Free(jason->KeyLookupTable.Buckets);
-            memcpy(&jason->KeyLookupTable, &newTable, sizeof(jasonHashTable));
+        }
+    }
+    
+#ifdef JASON_X86_SIMD
+    __attribute__((target("sse4.2")))
+    uint64_t jason_Match16_Sse42(const char *block, char c)
+    {
+        __m128i needle = _mm_set1_epi8(c);
+        uint64_t mask = 0;
+        for(int i = 0; i < 4; i++)
+        {
+            __m128i chunk = _mm_loadu_si128((const __m128i*)(block + i * 16));
+            mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)) << (i * 16);
         }
         
-        uint32_t hash = jason_HashKey(jason, parent, keyStr, keyLen);
-        return jason_HashInsertDirect(jason, &jason->KeyLookupTable, val, hash);
+        return mask;
     }
     
-    jasonValue *jason_HashLookup(jason *jason, jasonValue *parent, const char *keyStr, int32_t keyLen)
+    __attribute__((target("sse4.2")))
+    void jason_ClassifyBlock_Sse42(const char *block, jasonBlockMasks *masks)
     {
-        if(jason->KeyLookupTable.NumBuckets == 0)
+        masks->Quote = jason_Match16_Sse42(block, '"');
+        masks->Backslash = jason_Match16_Sse42(block, '\\');
+        masks->Whitespace = jason_Match16_Sse42(block, ' ') | jason_Match16_Sse42(block, '\n') | jason_Match16_Sse42(block, '\t') | jason_Match16_Sse42(block, '\r');
+        
+        // the structural characters all differ from one of '[' ']' '{' '}' only in bit 5, so fold that bit away first
+        masks->Structural = jason_Match16_Sse42(block, ':') | jason_Match16_Sse42(block, ',');
+        for(int i = 0; i < 4; i++)
         {
-            return NULL;
+            __m128i chunk = _mm_or_si128(_mm_loadu_si128((const __m128i*)(block + i * 16)), _mm_set1_epi8(0x20));
+            __m128i brackets = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('{')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('}')));
+            masks->Structural |= (uint64_t)(uint16_t)_mm_movemask_epi8(brackets) << (i * 16);
         }
+    }
+    
+    __attribute__((target("avx2")))
+    uint64_t jason_Match32_Avx2(__m256i lo, __m256i hi, char c)
+    {
+        __m256i needle = _mm256_set1_epi8(c);
+        uint64_t loMask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle));
+        uint64_t hiMask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle));
+        return loMask | (hiMask << 32);
+    }
+    
+    __attribute__((target("avx2")))
+    void jason_ClassifyBlock_Avx2(const char *block, jasonBlockMasks *masks)
+    {
+        __m256i lo = _mm256_loadu_si256((const __m256i*)block);
+        __m256i hi = _mm256_loadu_si256((const __m256i*)(block + 32));
+        __m256i bit5 = _mm256_set1_epi8(0x20);
+        __m256i foldedLo = _mm256_or_si256(lo, bit5);
+        __m256i foldedHi = _mm256_or_si256(hi, bit5);
+        
+        masks->Quote = jason_Match32_Avx2(lo, hi, '"');
+        masks->Backslash = jason_Match32_Avx2(lo, hi, '\\');
+        masks->Whitespace = jason_Match32_Avx2(lo, hi, ' ') | jason_Match32_Avx2(lo, hi, '\n') | jason_Match32_Avx2(lo, hi, '\t') | jason_Match32_Avx2(lo, hi, '\r');
+        masks->Structural = jason_Match32_Avx2(lo, hi, ':') | jason_Match32_Avx2(lo, hi, ',') | jason_Match32_Avx2(foldedLo, foldedHi, '{') | jason_Match32_Avx2(foldedLo, foldedHi, '}');
+    }
+#endif
+    
+    jasonClassifyBlockCb_t jason_SelectClassifier(void)
+    {
+        static jasonClassifyBlockCb_t classifier = NULL;
         
-        uint32_t hash = jason_HashKey(jason, parent, keyStr, keyLen);
-        uint32_t bucketIndex = hash % jason->KeyLookupTable.NumBuckets;
-        int32_t first = jason->KeyLookupTable.Buckets[bucketIndex];
-        if(first != 0)
+        jasonClassifyBlockCb_t chosen = JASON_ATOMIC_LOAD(&classifier);
+        if(chosen == NULL)
         {
-            for(jasonValue *key = jason->RootValue + first; key != NULL; key = jasonValue_GetNextSibling(key))
+            jasonClassifyBlockCb_t selected = jason_ClassifyBlock_Scalar;
+#ifdef JASON_X86_SIMD
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2"))
             {
-                jasonValue *keyParent = key + key->Parent;
-                if(keyParent->Value == parent->Value) // same parent
-                {
-                    if(strncmp(jasonValue_GetValue(key), keyStr, keyLen) == 0) // same key string
-                    {
-                        return key + 1;
-                    }
-                }
+                selected = jason_ClassifyBlock_Avx2;
+            }
+            else if(__builtin_cpu_supports("sse4.2"))
+            {
+                selected = jason_ClassifyBlock_Sse42;
             }
+#endif
+            JASON_ATOMIC_STORE(&classifier, selected);
+            chosen = selected;
         }
         
-        return NULL;
+        return chosen;
     }
     
-    jasonStatus jason_DeserializeStep(jason *jason, const char *strEnd, jasonValue **value, jasonValue *valueEnd)
+    // the characters of a string between its quotes: no control characters, and UTF-8 as Unicode table 3-7 allows it
+    int32_t jason_CheckString_Scalar(const char *str, jasonSize len)
     {
-        const char **str = &jason->ParsePosition;
-        jasonValue *val = (*value);
-        val->Value = *str;
-        val->ValueLen = 0;
-        val->Next = 0;
-        jasonValueType type = jasonValue_GetType(val);
+        const uint8_t *it = (const uint8_t*)str;
+        const uint8_t *end = it + len;
         
-        switch (type)
+        while(it < end)
         {
-            case jasonValueType_Object:
+            if(end - it >= 8)
             {
-                int32_t numChildren = 0;
-                
-                JASON_INCSTR((*str), strEnd);
-                JASON_SKIPWHITESPACE((*str), strEnd);
-                
-                jasonValue *last = NULL;
-                while(**str != '}')
+                // eight characters at a time while none is above 0x7F or below 0x20
+                uint64_t word;
+                memcpy(&word, it, sizeof(word));
+                if(((word | ((word - 0x2020202020202020ull) & ~word)) & 0x8080808080808080ull) == 0)
                 {
-                    JASON_INCVAL((*value), valueEnd);
-                    jasonValue *child = *value;
-                    jasonStatus status = jason_DeserializeStep(jason, strEnd, value, valueEnd);
-                    if(status != jasonStatus_Continue)
-                    {
-                        *value = val;
-                        return status;
-                    }
-                    
-                    JASON_SETOFFSET(val->ValueLen, val->ValueLen + child->ValueLen);
-                    numChildren++;
-                    if(numChildren % 2 == 1)
-                    {
-                        if(jasonValue_GetType(child) != jasonValueType_String)
-                        {
-                            *str = child->Value;
-                            return jasonStatus_Break(jasonStatus_ExpectedObjectKey);
-                        }
-                        
-                        if(**str != ':')
-                        {
-                            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                        }
-                        
-                        JASON_INCSTR((*str), strEnd);
-                        JASON_SKIPWHITESPACE((*str), strEnd);
-                        
-                        if(**str == '}')
-                        {
-                            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                        }
-                        
-                        status = jason_HashInsert(jason, child, val, jasonValue_GetValue(child), jasonValue_GetValueLen(child));
-                        if(status != jasonStatus_Continue)
-                        {
-                            return status;
-                        }
-                    }
-                    else
-                    {
-                        if(last != NULL)
-                        {
-                            JASON_SETOFFSET(last->Next, (child - last));
-                        }
-                        
-                        last = child;
-                        
-                        if(**str == '}')
-                        {
-                            break;
-                        }
-                        else
-                        {
-                            if(**str != ',')
-                            {
-                                return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                            }
-                            
-                            ++(*str);
-                            JASON_SKIPWHITESPACE((*str), strEnd);
-                        }
-                    }
+                    it += 8;
+                    continue;
                 }
-                
-                (*str)++;
-                
-                break;
             }
-                
-            case jasonValueType_Array:
+            
+            uint8_t c = *it;
+            if(c < 0x80)
             {
-                JASON_INCSTR((*str), strEnd);
-                JASON_SKIPWHITESPACE((*str), strEnd);
-                
-                jasonValue *last = NULL;
-                while(**str != ']')
+                if(c < 0x20)
                 {
-                    JASON_INCVAL((*value), valueEnd);
-                    jasonValue *child = *value;
-                    jasonStatus status = jason_DeserializeStep(jason, strEnd, value, valueEnd);
-                    if(status != jasonStatus_Continue)
-                    {
-                        *value = val;
-                        return status;
-                    }
-                    
-                    if(last != NULL)
-                    {
-                        JASON_SETOFFSET(last->Next, (child - last));
-                    }
-                    
-                    last = child;
-                    
-                    JASON_SETOFFSET(val->ValueLen, val->ValueLen + child->ValueLen);
-                    if(**str == ']')
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        if(**str != ',')
-                        {
-                            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                        }
-                        
-                        ++(*str);
-                        JASON_SKIPWHITESPACE((*str), strEnd);
-                    }
+                    return 0;
                 }
                 
-                (*str)++;
-                
-                break;
+                it++;
+                continue;
             }
-                
-            case jasonValueType_String:
+            
+            int32_t numContinuations = 0;
+            uint8_t low = 0x80;
+            uint8_t high = 0xBF;
+            if(c >= 0xC2 && c <= 0xDF)
             {
-                JASON_INCSTR((*str), strEnd);
-                
-                while(**str != '"')
-                {
-                    if(**str == '\\' && *(*str + 1) == '"')
-                    {
-                        JASON_INCSTR((*str), strEnd);
-                    }
-                    
-                    JASON_INCSTR((*str), strEnd);
-                };
-                
-                (*str)++;
-                JASON_SETOFFSET(val->ValueLen, *str - val->Value);
-                
-                break;
+                numContinuations = 1;
             }
-                
-            case jasonValueType_False:
+            else if(c >= 0xE0 && c <= 0xEF)
             {
-                if(strncmp(val->Value, "false", 5) != 0)
-                {
-                    return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                }
-                
-                val->ValueLen = 5;
-                (*str) += 5;
-                break;
+                // no overlong forms, no surrogates
+                numContinuations = 2;
+                low = (c == 0xE0) ? 0xA0 : 0x80;
+                high = (c == 0xED) ? 0x9F : 0xBF;
             }
-                
-            case jasonValueType_True:
+            else if(c >= 0xF0 && c <= 0xF4)
             {
-                if(strncmp(val->Value, "true", 4) != 0)
-                {
-                    return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                }
-                
-                val->ValueLen = 4;
-                (*str) += 4;
-                break;
+                // no overlong forms, nothing past U+10FFFF
+                numContinuations = 3;
+                low = (c == 0xF0) ? 0x90 : 0x80;
+                high = (c == 0xF4) ? 0x8F : 0xBF;
             }
-                
-            case jasonValueType_Null:
+            else
             {
-                if(strncmp(val->Value, "null", 4) != 0)
-                {
-                    return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                }
-                
-                val->ValueLen = 4;
-                (*str) += 4;
-                break;
+                return 0;
             }
-                
-            case jasonValueType_Number:
+            
+            if(end - it <= numContinuations || it[1] < low || it[1] > high)
             {
-                if(!isdigit(**str) && **str != '-')
-                {
-                    return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                }
-                
-                while(isdigit(**str) || **str == '.' || **str == 'E' || **str == 'e' || **str == '-')
-                {
-                    ++*str;
-                }
-                
-                if(!isdigit((*str)[-1]))
-                {
-                    return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
-                }
-                
-                JASON_SETOFFSET(val->ValueLen, *str - val->Value);
-                break;
+                return 0;
             }
-        }
-        
-        JASON_SKIPWHITESPACE((*str), strEnd);
-        
-        if(*str < strEnd)
-        {
-            if(*value >= valueEnd)
+            
+            for(int32_t i = 2; i <= numContinuations; i++)
             {
-                return jasonStatus_Break(jasonStatus_OutOfMemory);
+                if((it[i] & 0xC0) != 0x80)
+                {
+                    return 0;
+                }
             }
             
-            return jasonStatus_Continue;
-        }
-        else
-        {
-            return jasonStatus_Finished;
+            it += numContinuations + 1;
         }
+        
+        return 1;
     }
     
-    
-    void jason_Cleanup(jason *jason)
+#ifdef JASON_X86_SIMD
+    // the bytes that complete a sequence in 'input' for the lead bytes in 'prev', with the error flags of each pair of
+    // bytes looked up by nibble. Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"
+    __attribute__((target("avx2")))
+    __m256i jason_CheckUtf8Block_Avx2(__m256i input, __m256i prev)
     {
-        jason->Free(jason->RootValue);
-        jason->Free(jason->KeyLookupTable.Buckets);
-        jason->MaxValues = 0;
-        jason->NumValues = 0;
-        jason->KeyLookupTable.NumBuckets = 0;
-        jason->KeyLookupTable.NumKeys = 0;
+        // TooShort 0x01, TooLong 0x02, Overlong3 0x04, TooLarge 0x08, Surrogate 0x10, Overlong2 0x20,
+        // TooLarge1000 and Overlong4 0x40, TwoContinuations 0x80
+        const __m256i byte1High = _mm256_setr_epi8(
+            0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, (char)0x80, (char)0x80, (char)0x80, (char)0x80, 0x21, 0x01, 0x15, 0x49,
+            0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, (char)0x80, (char)0x80, (char)0x80, (char)0x80, 0x21, 0x01, 0x15, 0x49);
+        const __m256i byte1Low = _mm256_setr_epi8(
+            (char)0xE7, (char)0xA3, (char)0x83, (char)0x83, (char)0x8B, (char)0xCB, (char)0xCB, (char)0xCB,
+            (char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xDB, (char)0xCB, (char)0xCB,
+            (char)0xE7, (char)0xA3, (char)0x83, (char)0x83, (char)0x8B, (char)0xCB, (char)0xCB, (char)0xCB,
+            (char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xCB, (char)0xDB, (char)0xCB, (char)0xCB);
+        const __m256i byte2High = _mm256_setr_epi8(
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, (char)0xE6, (char)0xAE, (char)0xBA, (char)0xBA, 0x01, 0x01, 0x01, 0x01,
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, (char)0xE6, (char)0xAE, (char)0xBA, (char)0xBA, 0x01, 0x01, 0x01, 0x01);
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        
+        __m256i carried = _mm256_permute2x128_si256(prev, input, 0x21);
+        __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+        __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+        __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+        
+        __m256i flags = _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+        flags = _mm256_and_si256(flags, _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble)));
+        flags = _mm256_and_si256(flags, _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+        
+        // the third and fourth bytes of a sequence must be continuations, and only those may follow a continuation
+        __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+        __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+        __m256i mustContinue = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+        return _mm256_xor_si256(mustContinue, flags);
     }
     
-    void *jason_Malloc(size_t *size)
+    // jason_CheckString_Scalar 32 bytes at a time, the UTF-8 of a block only checked when it has bytes above 0x7F
+    __attribute__((target("avx2")))
+    int32_t jason_CheckString_Avx2(const char *str, jasonSize len)
     {
-        void *ret = malloc(*size);
-        if(ret == NULL)
+        // lead bytes in the last three places of a block that want more bytes than the block has
+        const __m256i incompleteAbove = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+        const __m256i controlMax = _mm256_set1_epi8(0x1F);
+        __m256i prev = _mm256_setzero_si256();
+        __m256i incomplete = _mm256_setzero_si256();
+        __m256i error = _mm256_setzero_si256();
+        
+        if(len < 32)
         {
-            *size = 0;
+            // not worth padding a block for
+            return jason_CheckString_Scalar(str, len);
         }
         
-        return ret;
+        for(jasonSize i = 0; i < len; i += 32)
+        {
+            __m256i input;
+            if(len - i >= 32)
+            {
+                input = _mm256_loadu_si256((const __m256i*)(str + i));
+            }
+            else
+            {
+                // padded with spaces, which also end any sequence left open
+                char tail[32];
+                memset(tail, ' ', sizeof(tail));
+                memcpy(tail, str + i, (size_t)(len - i));
+                input = _mm256_loadu_si256((const __m256i*)tail);
+            }
+            
+            __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(input, controlMax), input);
+            if(!_mm256_testz_si256(control, control))
+            {
+                return 0;
+            }
+            
+            if(_mm256_movemask_epi8(input) == 0)
+            {
+                error = _mm256_or_si256(error, incomplete);
+                incomplete = _mm256_setzero_si256();
+            }
+            else
+            {
+                error = _mm256_or_si256(error, jason_CheckUtf8Block_Avx2(input, prev));
+                incomplete = _mm256_subs_epu8(input, incompleteAbove);
+            }
+            
+            prev = input;
+        }
+        
+        error = _mm256_or_si256(error, incomplete);
+        return _mm256_testz_si256(error, error);
     }
+#endif
     
-    void jason_Free(void * ptr)
+    jasonCheckStringCb_t jason_SelectStringChecker(void)
     {
-        free(ptr);
+        static jasonCheckStringCb_t checker = NULL;
+        
+        jasonCheckStringCb_t chosen = JASON_ATOMIC_LOAD(&checker);
+        if(chosen == NULL)
+        {
+            jasonCheckStringCb_t selected = jason_CheckString_Scalar;
+#ifdef JASON_X86_SIMD
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2"))
+            {
+                selected = jason_CheckString_Avx2;
+            }
+#endif
+            JASON_ATOMIC_STORE(&checker, selected);
+            chosen = selected;
+        }
+        
+        return chosen;
     }
     
-    void *jason_Realloc(void *ptr, size_t *size)
+    int jason_CountTrailingZeros(uint64_t bits)
     {
-        void *newPtr = realloc(ptr, *size);
-        if(newPtr == NULL)
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        int count = 0;
+        while((bits & 1) == 0)
         {
-            *size = 0;
+            bits >>= 1;
+            count++;
         }
         
-        return newPtr;
+        return count;
+#endif
     }
     
-    uint32_t jason_Hash(char *key, size_t bytes)
+#ifdef JASON_STATS
+    // wall time in nanoseconds from a clock that never steps back. CLOCK_MONOTONIC needs the POSIX extensions,
+    // _POSIX_C_SOURCE under a strict -std; without them clock() is all there is, the CPU time of every thread
+    uint64_t jason_StatsNow(void)
     {
-        uint32_t hash = 5831;
-        for(uint32_t i = 0; i < bytes; ++i)
+#ifdef CLOCK_MONOTONIC
+        struct timespec now;
+        if(clock_gettime(CLOCK_MONOTONIC, &now) == 0)
         {
-            hash = 33 * hash + key[i];
+            return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
         }
-        
-        return hash;
+#endif
+        return (uint64_t)clock() * (1000000000 / CLOCKS_PER_SEC);
     }
     
-    jasonStatus jason_Deserialize(jason *jason, const char *json, int32_t jsonLen)
+    void jason_StatsStage(jason *jason, jasonStage stage, int32_t isEnd)
     {
-        if(json == NULL || jsonLen <= 0)
+        jasonStats *stats = jason->Stats;
+        if(stats == NULL)
         {
-            return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+            return;
         }
         
-        if(jason->Malloc == NULL || jason->Free == NULL)
+        if(!isEnd)
         {
-            jason->Malloc = jason_Malloc;
-            jason->Free = jason_Free;
+            if(stats->OnStageBegin != NULL)
+            {
+                stats->OnStageBegin(stats->HookContext, stage);
+            }
+            
+            stats->StageStart[stage] = JASON_STATS_NOW();
+            return;
         }
         
-        if(jason->Hash == NULL)
+        stats->StageNanoseconds[stage] += JASON_STATS_NOW() - stats->StageStart[stage];
+        if(stats->OnStageEnd != NULL)
         {
-            jason->Hash = jason_Hash;
+            stats->OnStageEnd(stats->HookContext, stage);
         }
-        
-        // alloc initial memory
-        jason->MaxValues = 32;
-        size_t memLength = jason->MaxValues * sizeof(jasonValue);
-        jason->RootValue = jason->Malloc(&memLength);
-        
-        if(jason->RootValue == NULL)
+    }
+    
+    void jason_StatsValue(jason *jason, jasonValue *value)
+    {
+        jasonStats *stats = jason->Stats;
+        if(stats != NULL)
+        {
+            jasonValueType type = jasonValue_GetType(value);
+            stats->NumValues[type]++;
+            
+            switch(type)
+            {
+                case jasonValueType_Object:
+                case jasonValueType_Array:
+                    stats->ValueBytes[type] += 2;
+                    break;
+                    
+                case jasonValueType_String:
+                    stats->ValueBytes[type] += (uint64_t)jasonValue_GetValueLen(value) + 2;
+                    break;
+                    
+                default:
+                    stats->ValueBytes[type] += (uint64_t)jasonValue_GetValueLen(value);
+                    break;
+            }
+        }
+    }
+    
+    void jason_StatsProbe(jason *jason, uint32_t groups)
+    {
+        jasonStats *stats = jason->Stats;
+        if(stats != NULL)
+        {
+            stats->IndexedLookups++;
+            stats->ProbedGroups += groups;
+            if(groups > stats->LongestProbe)
+            {
+                stats->LongestProbe = groups;
+            }
+        }
+    }
+#endif
+    
+    // defined with the number parsing
+    uint64_t jason_Multiply128(uint64_t a, uint64_t b, uint64_t *low);
+    
+    uint64_t *jason_HashSeedState(void)
+    {
+        static uint64_t seed = 0;
+        return &seed;
+    }
+    
+    // bits for the seed: the system's random source where there is one, then the cycle counter or the clock and where
+    // the loader put the stack, this code and its data, which all change from run to run
+    uint64_t jason_SeedEntropy(void)
+    {
+        uint64_t bits = 0;
+#ifdef JASON_MMAP
+        int file = open("/dev/urandom", O_RDONLY);
+        if(file >= 0)
+        {
+            if(read(file, &bits, sizeof(bits)) != (ssize_t)sizeof(bits))
+            {
+                bits = 0;
+            }
+            
+            close(file);
+        }
+        
+        bits ^= (uint64_t)getpid() << 43;
+#endif
+#ifdef JASON_X86_SIMD
+        bits ^= __builtin_ia32_rdtsc();
+#endif
+        bits ^= (uint64_t)time(NULL) << 20;
+        bits ^= (uint64_t)clock();
+        bits ^= (uint64_t)(uintptr_t)&bits << 13;
+        bits ^= (uint64_t)(uintptr_t)jason_HashSeedState << 29;
+        bits ^= (uint64_t)(uintptr_t)jason_HashSeedState() << 37;
+        return bits;
+    }
+    
+    // the seed of jason_Hash, the same for every thread. The first thread to need it draws it, any other thread that
+    // drew one at the same time drops its own
+    uint64_t jason_HashSeed(void)
+    {
+        uint64_t *state = jason_HashSeedState();
+        uint64_t seed = JASON_ATOMIC_LOAD(state);
+        if(seed == 0)
+        {
+            // splitmix64 finaliser, so every bit of the seed depends on all of the entropy
+            uint64_t bits = jason_SeedEntropy() + 0x9E3779B97F4A7C15ull;
+            bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+            bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+            
+            uint64_t drawn = (bits ^ (bits >> 31)) | 1;
+            seed = 0;
+            if(JASON_ATOMIC_SET_FROM(state, &seed, drawn))
+            {
+                seed = drawn;
+            }
+        }
+        
+        return seed;
+    }
+    
+    // replace the process seed, before anything is hashed with it. 0 is taken as 1
+    void jason_SetHashSeed(uint64_t seed)
+    {
+        JASON_ATOMIC_STORE(jason_HashSeedState(), (seed != 0) ? seed : 1);
+    }
+    
+    uint64_t jason_HashMix(uint64_t a, uint64_t b)
+    {
+        uint64_t low = 0;
+        uint64_t high = jason_Multiply128(a, b, &low);
+        return high ^ low;
+    }
+    
+    uint64_t jason_HashRead64(const uint8_t *bytes)
+    {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+    
+    uint64_t jason_HashRead32(const uint8_t *bytes)
+    {
+        uint32_t word;
+        memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+    
+    // wyhash: 16 bytes per multiply, and keys of up to 16 bytes in a single one. Without the seed, colliding keys cannot be
+    // worked out ahead of time
+    uint64_t jason_Hash64(const char *key, size_t bytes, uint64_t seed)
+    {
+        static const uint64_t primes[] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull };
+        const uint8_t *it = (const uint8_t*)key;
+        uint64_t a = 0;
+        uint64_t b = 0;
+        
+        seed ^= jason_HashMix(seed ^ primes[0], primes[1]);
+        if(bytes <= 16)
+        {
+            if(bytes >= 4)
+            {
+                size_t middle = (bytes >> 3) << 2;
+                a = (jason_HashRead32(it) << 32) | jason_HashRead32(it + middle);
+                b = (jason_HashRead32(it + bytes - 4) << 32) | jason_HashRead32(it + bytes - 4 - middle);
+            }
+            else if(bytes > 0)
+            {
+                a = ((uint64_t)it[0] << 16) | ((uint64_t)it[bytes >> 1] << 8) | it[bytes - 1];
+            }
+        }
+        else
+        {
+            size_t remaining = bytes;
+            for(; remaining > 16; remaining -= 16, it += 16)
+            {
+                seed = jason_HashMix(jason_HashRead64(it) ^ primes[1], jason_HashRead64(it + 8) ^ seed);
+            }
+            
+            a = jason_HashRead64(it + remaining - 16);
+            b = jason_HashRead64(it + remaining - 8);
+        }
+        
+        return jason_HashMix(primes[1] ^ bytes, jason_HashMix(a ^ primes[1], b ^ seed));
+    }
+    
+    uint32_t jason_HashSeeded(const char *key, size_t bytes, uint64_t seed)
+    {
+        uint64_t hash = jason_Hash64(key, bytes, seed);
+        return (uint32_t)(hash ^ (hash >> 32));
+    }
+    
+    // the default hash, seeded with jason_HashSeed
+    uint32_t jason_Hash(char *key, size_t bytes)
+    {
+        return jason_HashSeeded(key, bytes, jason_HashSeed());
+    }
+    
+    uint32_t jason_HashKey(jason *jason, const char *key, int32_t keyLen)
+    {
+        if(jason->Hash == jason_Hash)
+        {
+            return jason_HashSeeded(key, keyLen, jason->HashSeed != 0 ? jason->HashSeed : jason_HashSeed());
+        }
+        
+        return jason->Hash((char*)key, keyLen);
+    }
+    
+    // double *buffer until it holds at least 'needed' bytes, existing contents are kept
+    jasonStatus jason_GrowBuffer(jason *jason, void **buffer, size_t *size, size_t needed)
+    {
+        if(needed <= *size)
+        {
+            return jasonStatus_Continue;
+        }
+        
+        size_t memLength = *size > 0 ? *size : 256;
+        while(memLength < needed)
+        {
+            memLength *= 2;
+        }
+        
+        void *newBuffer = NULL;
+        if(*buffer != NULL && jason->Realloc != NULL)
+        {
+            newBuffer = jason->Realloc(*buffer, &memLength);
+        }
+        else
+        {
+            newBuffer = jason->Malloc(&memLength);
+            if(newBuffer != NULL && *buffer != NULL)
+            {
+                memcpy(newBuffer, *buffer, *size);
+                jason->Free(*buffer);
+            }
+        }
+        
+        if(newBuffer == NULL || memLength < needed)
         {
             return jasonStatus_Break(jasonStatus_OutOfMemory);
         }
         
-        jason->MaxValues = (int32_t)(memLength / sizeof(jasonValue));
-        memset(jason->RootValue, 0, jason->MaxValues * sizeof(jasonValue));
+        JASON_STATS_ADD(jason, BufferGrowths, 1);
+        *buffer = newBuffer;
+        *size = memLength;
+        return jasonStatus_Continue;
+    }
+    
+    uint32_t jason_DirectorySlot(jasonSize object, int32_t directorySize)
+    {
+        return (uint32_t)(((uint64_t)object * 0x9E3779B97F4A7C15ULL) >> 32) & (uint32_t)(directorySize - 1);
+    }
+    
+    jasonObjectIndex *jason_FindObjectIndex(jason *jason, jasonSize object)
+    {
+        jasonHashTable *table = &jason->KeyLookupTable;
+        if(table->NumIndexed == 0)
+        {
+            return NULL;
+        }
         
-        // begin
-        jasonValue *valuesEnd = jason->RootValue + jason->MaxValues;
-        jasonValue *valuesIt = jason->RootValue;
-        const char *jsonBegin = json;
-        const char *end = jsonBegin + jsonLen;
-        jason->NumValues = 0;
-        jason->ParsePosition = json;
-        jasonStatus status = jasonStatus_Continue;
+        uint32_t mask = (uint32_t)table->DirectorySize - 1;
+        for(uint32_t i = jason_DirectorySlot(object, table->DirectorySize); ; i = (i + 1) & mask)
+        {
+            jasonObjectIndex *entry = table->Directory + i;
+            if(entry->Capacity == 0)
+            {
+                return NULL;
+            }
+            
+            if(entry->Object == object)
+            {
+                return entry;
+            }
+        }
+    }
+    
+    jasonStatus jason_AddObjectIndex(jason *jason, jasonObjectIndex *index)
+    {
+        jasonHashTable *table = &jason->KeyLookupTable;
         
-        while(status == jasonStatus_Continue)
+        if((table->NumIndexed + 1) * 2 > table->DirectorySize)
         {
-            jasonValue *lastValue = valuesIt;
-            status = jason_DeserializeStep(jason, end, &valuesIt, valuesEnd);
-            jason->NumValues += (int32_t)(valuesIt - lastValue);
+            // double the directory, the per-object tables stay where they are
+            int32_t newSize = table->DirectorySize > 0 ? table->DirectorySize * 2 : 16;
+            size_t memLength = newSize * sizeof(jasonObjectIndex);
+            jasonObjectIndex *newDirectory = jason->Malloc(&memLength);
             
-            // more memory?
-            if(status == jasonStatus_OutOfMemory)
+            if(newDirectory == NULL || memLength < newSize * sizeof(jasonObjectIndex))
             {
-                int32_t valuesStep = (jason->MaxValues / 2);
-                
-                if(jason->MaxValues > INT_MAX - valuesStep)
+                jason->Free(newDirectory);
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            memset(newDirectory, 0, newSize * sizeof(jasonObjectIndex));
+            for(int32_t i = 0; i < table->DirectorySize; i++)
+            {
+                jasonObjectIndex *entry = table->Directory + i;
+                if(entry->Capacity != 0)
                 {
-                    valuesStep = (INT_MAX - jason->MaxValues);
-                    
-                    if(valuesStep <= 0)
+                    uint32_t slot = jason_DirectorySlot(entry->Object, newSize);
+                    while(newDirectory[slot].Capacity != 0)
                     {
-                        break;
+                        slot = (slot + 1) & (newSize - 1);
                     }
+                    
+                    newDirectory[slot] = *entry;
                 }
-                
-                int32_t newMaxValues = jason->MaxValues + valuesStep;
-                size_t newMemLength = newMaxValues * sizeof(jasonValue);
-                jasonValue *newRoot = jason->Malloc(&newMemLength);
-                
-                if(newMemLength <= memLength || abs((int)(memLength - newMemLength)) < sizeof(jasonValue))
+            }
+            
+            jason->Free(table->Directory);
+            table->Directory = newDirectory;
+            table->DirectorySize = newSize;
+            JASON_STATS_ADD(jason, DirectoryGrowths, 1);
+        }
+        
+        uint32_t slot = jason_DirectorySlot(index->Object, table->DirectorySize);
+        while(table->Directory[slot].Capacity != 0)
+        {
+            slot = (slot + 1) & (table->DirectorySize - 1);
+        }
+        
+        table->Directory[slot] = *index;
+        table->NumIndexed++;
+        return jasonStatus_Continue;
+    }
+    
+    // bit i set for each of the 16 control bytes equal to 'match'
+    uint32_t jason_MatchGroup(const uint8_t *control, uint8_t match)
+    {
+#if defined(JASON_X86_SIMD) && defined(__SSE2__)
+        __m128i group = _mm_loadu_si128((const __m128i*)control);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)match)));
+#else
+        uint32_t mask = 0;
+        for(int i = 0; i < 16; i++)
+        {
+            mask |= (uint32_t)(control[i] == match) << i;
+        }
+        
+        return mask;
+#endif
+    }
+    
+    // order keys by length, then by their bytes
+    int jason_CompareKey(jasonValue *key, const char *keyStr, int32_t keyLen)
+    {
+        jasonSize len = jasonValue_GetValueLen(key);
+        if(len != keyLen)
+        {
+            return (len < keyLen) ? -1 : 1;
+        }
+        
+        return memcmp(jasonValue_GetValue(key), keyStr, keyLen);
+    }
+    
+    int jason_CompareKeyEntries(jasonValue *object, jasonSize a, jasonSize b)
+    {
+        return jason_CompareKey(object + a, jasonValue_GetValue(object + b), (int32_t)jasonValue_GetValueLen(object + b));
+    }
+    
+    // the offsets of an object's keys in key order. Heapsort, so no choice of keys makes it quadratic
+    void jason_SortObjectKeys(jasonValue *object, jasonSize *entries)
+    {
+        jasonSize count = 0;
+        for(jasonValue *key = object + 1; ; key += key->Next)
+        {
+            entries[count++] = (jasonSize)(key - object);
+            if(key->Next == 0)
+            {
+                break;
+            }
+        }
+        
+        for(jasonSize end = count, start = count / 2; end > 1;)
+        {
+            jasonSize root = 0;
+            if(start > 0)
+            {
+                root = --start;
+            }
+            else
+            {
+                jasonSize top = entries[0];
+                entries[0] = entries[--end];
+                entries[end] = top;
+            }
+            
+            for(jasonSize child = root * 2 + 1; child < end; child = root * 2 + 1)
+            {
+                if(child + 1 < end && jason_CompareKeyEntries(object, entries[child], entries[child + 1]) < 0)
                 {
-                    jason->Free(newRoot);
-                    newRoot = NULL;
+                    child++;
                 }
                 
-                if(newRoot == NULL)
+                if(jason_CompareKeyEntries(object, entries[root], entries[child]) >= 0)
                 {
-                    return jasonStatus_Break(jasonStatus_OutOfMemory);
+                    break;
                 }
                 
-                newMaxValues = (int32_t)(memLength / sizeof(jasonValue));
-                
-                memcpy(newRoot, jason->RootValue, jason->MaxValues * sizeof(jasonValue));
-                memset(newRoot + (jason->MaxValues * sizeof(jasonValue)), 0, (newMaxValues - jason->NumValues) * sizeof(jasonValue));
-                
-                jason->Free(jason->RootValue);
-                jason->RootValue = newRoot;
-                jason->MaxValues = newMaxValues;
-                valuesIt = jason->RootValue + jason->NumValues;
-                valuesEnd = jason->RootValue + jason->MaxValues;
-                memLength = newMemLength;
+                jasonSize swap = entries[root];
+                entries[root] = entries[child];
+                entries[child] = swap;
+                root = child;
+            }
+        }
+    }
+    
+    // build an open-addressed table over the keys of a large object, keyed by 7-bit hash fingerprints in groups of 16
+    jasonStatus jason_IndexObject(jason *jason, jasonSize object, jasonSize numKeys)
+    {
+        jasonHashTable *table = &jason->KeyLookupTable;
+        jasonObjectIndex index;
+        index.Object = object;
+        index.Capacity = 16;
+        
+        while(index.Capacity - index.Capacity / 8 < numKeys)
+        {
+            if(index.Capacity > INT_MAX / 2)
+            {
+                return jasonStatus_Break(jasonStatus_IntegerOverflow);
+            }
+            
+            index.Capacity *= 2;
+        }
+        
+        size_t bytes = (size_t)index.Capacity * (1 + sizeof(jasonSize));
+        jasonStatus status = jason_GrowBuffer(jason, (void**)&table->Slots, &table->SlotsSize, table->SlotsUsed + bytes);
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        index.Offset = table->SlotsUsed;
+        table->SlotsUsed += bytes;
+        JASON_STATS_ADD(jason, ObjectsIndexed, 1);
+        JASON_STATS_ADD(jason, IndexedKeys, numKeys);
+        
+        uint8_t *control = table->Slots + index.Offset;
+        jasonSize *entries = (jasonSize*)(control + index.Capacity);
+        uint32_t groupMask = (uint32_t)(index.Capacity / 16) - 1;
+        memset(control, JASON_SLOT_EMPTY, index.Capacity);
+        
+        jasonValue *obj = jason->RootValue + object;
+        index.Sorted = 0;
+        
+        for(jasonValue *key = obj + 1; !index.Sorted; key += key->Next)
+        {
+            uint32_t hash = jason_HashKey(jason, jasonValue_GetValue(key), jasonValue_GetValueLen(key));
+            uint32_t firstGroup = (hash >> 7) & groupMask;
+            for(uint32_t group = firstGroup; ; group = (group + 1) & groupMask)
+            {
+                uint32_t empty = jason_MatchGroup(control + group * 16, JASON_SLOT_EMPTY);
+                if(empty != 0)
+                {
+                    uint32_t slot = group * 16 + jason_CountTrailingZeros(empty);
+                    control[slot] = (uint8_t)(hash & 0x7F);
+                    entries[slot] = (jasonSize)(key - obj);
+                    break;
+                }
                 
-                // reset last value, in case we finished half-way through it
-                jason->ParsePosition = valuesIt->Value;
-                valuesIt--;
-                status = jasonStatus_Continue;
+                if(((group - firstGroup) & groupMask) + 1 >= JASON_MAX_PROBE_GROUPS)
+                {
+                    // keys that collide this much were chosen to, sorted they cost O(log n) a lookup whatever they are
+                    jason_SortObjectKeys(obj, entries);
+                    index.Sorted = 1;
+                    JASON_STATS_ADD(jason, SortedIndexes, 1);
+                    break;
+                }
+            }
+            
+            if(key->Next == 0)
+            {
+                break;
             }
         }
         
-        if(status == jasonStatus_Finished)
+        return jason_AddObjectIndex(jason, &index);
+    }
+    
+    jasonValue *jason_ScanObjectKeys(jasonValue *parent, const char *keyStr, int32_t keyLen)
+    {
+        for(jasonValue *key = parent + 1; ; key += key->Next)
         {
-            jason->ParsePosition = jsonBegin;
+            if(jasonValue_GetValueLen(key) == keyLen && memcmp(jasonValue_GetValue(key), keyStr, keyLen) == 0)
+            {
+                return key + 1;
+            }
+            
+            if(key->Next == 0)
+            {
+                return NULL;
+            }
         }
-        else
+    }
+    
+    jasonValue *jason_ProbeObjectIndex(jason *jason, jasonValue *parent, jasonObjectIndex *index, const char *keyStr, int32_t keyLen, uint32_t hash)
+    {
+        const uint8_t *control = jason->KeyLookupTable.Slots + index->Offset;
+        const jasonSize *entries = (const jasonSize*)(control + index->Capacity);
+        uint32_t groupMask = (uint32_t)(index->Capacity / 16) - 1;
+        uint32_t firstGroup = (hash >> 7) & groupMask;
+        
+        if(index->Sorted)
         {
-            if(jason->RootValue != NULL)
+            jasonSize low = 0;
+            jasonSize high = parent->ValueLen / 2;
+            while(low < high)
             {
-                jason->Free(jason->RootValue);
-                jason->RootValue = NULL;
+                jasonSize middle = low + (high - low) / 2;
+                int order = jason_CompareKey(parent + entries[middle], keyStr, keyLen);
+                if(order == 0)
+                {
+                    JASON_STATS_PROBE(jason, 1);
+                    return parent + entries[middle] + 1;
+                }
+                
+                if(order < 0)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
             }
+            
+            JASON_STATS_PROBE(jason, 1);
+            return NULL;
         }
         
-        return status;
+        for(uint32_t group = firstGroup; ; group = (group + 1) & groupMask)
+        {
+            for(uint32_t match = jason_MatchGroup(control + group * 16, (uint8_t)(hash & 0x7F)); match != 0; match &= match - 1)
+            {
+                jasonValue *key = parent + entries[group * 16 + jason_CountTrailingZeros(match)];
+                if(jasonValue_GetValueLen(key) == keyLen && memcmp(jasonValue_GetValue(key), keyStr, keyLen) == 0)
+                {
+                    JASON_STATS_PROBE(jason, ((group - firstGroup) & groupMask) + 1);
+                    return key + 1;
+                }
+            }
+            
+            if(jason_MatchGroup(control + group * 16, JASON_SLOT_EMPTY) != 0)
+            {
+                JASON_STATS_PROBE(jason, ((group - firstGroup) & groupMask) + 1);
+                return NULL;
+            }
+        }
+    }
+    
+    // defined with the parsing entry points
+    jasonStatus jason_Expand(jason *jason, jasonValue *container, jasonExpansion **expansion);
+    jasonStatus jason_DeserializeSax(jasonSaxHandler *handler, const char *json, jasonSize jsonLen);
+    
+    // the node and document holding a container's children, expanding a lazy container on first use
+    jasonValue *jason_ResolveLazy(jason **document, jasonValue *container)
+    {
+        if(container->ValueLen >= 0 || !jasonValue_IsLazy(container))
+        {
+            return container;
+        }
+        
+        jasonExpansion *expansion = NULL;
+        if(jason_Expand(*document, container, &expansion) != jasonStatus_Continue)
+        {
+            return NULL;
+        }
+        
+        *document = &expansion->Document;
+        return expansion->Document.RootValue;
+    }
+    
+    // jasonValue_GetFirstChild that also sees into containers skipped by jasonFlag_Lazy
+    jasonValue *jason_GetFirstChild(jason *jason, jasonValue *parent)
+    {
+        parent = jason_ResolveLazy(&jason, parent);
+        return (parent != NULL) ? jasonValue_GetFirstChild(parent) : NULL;
+    }
+    
+    jasonValue *jason_HashLookup(jason *jason, jasonValue *parent, const char *keyStr, int32_t keyLen)
+    {
+        parent = jason_ResolveLazy(&jason, parent);
+        if(parent == NULL || jasonValue_GetType(parent) != jasonValueType_Object || parent->ValueLen == 0)
+        {
+            return NULL;
+        }
+        
+        jasonObjectIndex *index = jason_FindObjectIndex(jason, (jasonSize)(parent - jason->RootValue));
+        if(index == NULL)
+        {
+            // small object, scan its keys
+            JASON_STATS_ADD(jason, ScannedLookups, 1);
+            return jason_ScanObjectKeys(parent, keyStr, keyLen);
+        }
+        
+        return jason_ProbeObjectIndex(jason, parent, index, keyStr, keyLen, jason_HashKey(jason, keyStr, keyLen));
+    }
+    
+    // bit i set for every character preceded by an odd-length run of backslashes
+    uint64_t jason_FindEscaped(uint64_t backslash, uint64_t *prevEndsOddBackslash)
+    {
+        const uint64_t evenBits = 0x5555555555555555ULL;
+        const uint64_t oddBits = ~evenBits;
+        
+        uint64_t startEdges = backslash & ~(backslash << 1);
+        uint64_t evenStartMask = evenBits ^ *prevEndsOddBackslash;
+        uint64_t evenStarts = startEdges & evenStartMask;
+        uint64_t oddStarts = startEdges & ~evenStartMask;
+        uint64_t evenCarries = backslash + evenStarts;
+        uint64_t oddCarries = backslash + oddStarts;
+        uint64_t endsOdd = oddCarries < backslash ? 1 : 0;
+        
+        oddCarries |= *prevEndsOddBackslash;
+        *prevEndsOddBackslash = endsOdd;
+        
+        uint64_t evenCarryEnds = evenCarries & ~backslash;
+        uint64_t oddCarryEnds = oddCarries & ~backslash;
+        return (evenCarryEnds & oddBits) | (oddCarryEnds & evenBits);
+    }
+    
+    uint64_t jason_PrefixXor(uint64_t bits)
+    {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+    
+    jasonStatus jason_BuildStructuralIndex(jason *jason, const char *json, jasonSize jsonLen)
+    {
+        jasonStructuralIndex *index = &jason->StructuralIndex;
+        size_t memLength = ((size_t)jsonLen + 1) * sizeof(jasonSize);
+        index->Positions = jason->Malloc(&memLength);
+        
+        if(index->Positions == NULL || memLength < ((size_t)jsonLen + 1) * sizeof(jasonSize))
+        {
+            jason->Free(index->Positions);
+            index->Positions = NULL;
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        jasonClassifyBlockCb_t classify = jason_SelectClassifier();
+        jasonSize *out = index->Positions;
+        uint64_t prevEscaped = 0;
+        uint64_t prevInString = 0;
+        uint64_t prevSeparator = 1; // the first character always starts a token
+        
+        for(jasonSize blockStart = 0; blockStart < jsonLen; blockStart += 64)
+        {
+            const char *block = json + blockStart;
+            char padded[64];
+            if(jsonLen - blockStart < 64)
+            {
+                memset(padded, ' ', sizeof(padded));
+                memcpy(padded, block, jsonLen - blockStart);
+                block = padded;
+            }
+            
+            jasonBlockMasks masks;
+            classify(block, &masks);
+            
+            uint64_t escaped = jason_FindEscaped(masks.Backslash, &prevEscaped);
+            uint64_t quotes = masks.Quote & ~escaped;
+            uint64_t inString = jason_PrefixXor(quotes) ^ prevInString;
+            prevInString = (uint64_t)((int64_t)inString >> 63);
+            
+            uint64_t whitespace = masks.Whitespace & ~inString;
+            uint64_t structural = masks.Structural & ~inString;
+            uint64_t separators = whitespace | structural;
+            uint64_t atoms = ~(separators | quotes | inString) & ((separators << 1) | prevSeparator);
+            prevSeparator = separators >> 63;
+            
+            uint64_t bits = structural | quotes | atoms;
+            while(bits != 0)
+            {
+                *out++ = blockStart + jason_CountTrailingZeros(bits);
+                bits &= bits - 1;
+            }
+        }
+        
+        *out = jsonLen;
+        index->Source = json;
+        index->NumPositions = (jasonSize)(out - index->Positions);
+        index->Cursor = 0;
+        
+        return jasonStatus_Continue;
+    }
+    
+    // first indexed position after 'position', or the end of the input
+    const char *jason_NextStructural(jason *jason, const char *position)
+    {
+        jasonStructuralIndex *index = &jason->StructuralIndex;
+        jasonSize offset = (jasonSize)(position - index->Source);
+        
+        if(index->Cursor > 0 && index->Positions[index->Cursor - 1] > offset)
+        {
+            // rewound, binary search back
+            jasonSize low = 0;
+            jasonSize high = index->Cursor - 1;
+            while(low < high)
+            {
+                jasonSize mid = low + (high - low) / 2;
+                if(index->Positions[mid] > offset)
+                {
+                    high = mid;
+                }
+                else
+                {
+                    low = mid + 1;
+                }
+            }
+            
+            index->Cursor = low;
+        }
+        
+        while(index->Cursor < index->NumPositions && index->Positions[index->Cursor] <= offset)
+        {
+            index->Cursor++;
+        }
+        
+        return index->Source + index->Positions[index->Cursor];
+    }
+    
+    // as jason_SkipContainer, going on from where an earlier call with the same state ran out of input. Whole blocks of 64
+    // are kept in the state, *resume is left on the first byte that is not in one and is scanned again with more input
+    const char *jason_SkipContainerFrom(const char *from, const char *end, jasonSkipState *state, const char **resume)
+    {
+        jasonClassifyBlockCb_t classify = jason_SelectClassifier();
+        
+        for(const char *block = from; block < end; block += 64)
+        {
+            const char *data = block;
+            char padded[64];
+            int32_t isPartial = (end - block < 64);
+            if(isPartial)
+            {
+                memset(padded, ' ', sizeof(padded));
+                memcpy(padded, block, end - block);
+                data = padded;
+            }
+            
+            jasonBlockMasks masks;
+            classify(data, &masks);
+            
+            uint64_t prevEscaped = state->PrevEscaped;
+            uint64_t escaped = jason_FindEscaped(masks.Backslash, &prevEscaped);
+            uint64_t inString = jason_PrefixXor(masks.Quote & ~escaped) ^ state->PrevInString;
+            jasonSize depth = state->Depth;
+            
+            for(uint64_t bits = masks.Structural & ~inString; bits != 0; bits &= bits - 1)
+            {
+                int offset = jason_CountTrailingZeros(bits);
+                char c = data[offset];
+                if(c == '{' || c == '[')
+                {
+                    depth++;
+                }
+                else if((c == '}' || c == ']') && --depth == 0)
+                {
+                    return block + offset + 1;
+                }
+            }
+            
+            if(isPartial)
+            {
+                // the padding says nothing about what follows, the block is scanned again whole
+                *resume = block;
+                return NULL;
+            }
+            
+            state->PrevEscaped = prevEscaped;
+            state->PrevInString = (uint64_t)((int64_t)inString >> 63);
+            state->Depth = depth;
+        }
+        
+        *resume = end;
+        return NULL;
+    }
+    
+    // just past the bracket closing the container that starts at 'open', NULL if it is not closed before 'end'. Nothing
+    // in between is validated, brackets inside strings are told apart with the masks of the structural index
+    const char *jason_SkipContainer(const char *open, const char *end)
+    {
+        jasonSkipState state;
+        memset(&state, 0, sizeof(state));
+        const char *resume = NULL;
+        return jason_SkipContainerFrom(open, end, &state, &resume);
+    }
+    
+    // just past the closing quote of the string starting at 'quote', NULL if it is not closed before 'end'
+    const char *jason_SkipString(const char *quote, const char *end)
+    {
+        for(const char *str = quote + 1; str < end; str++)
+        {
+            str = memchr(str, '"', end - str);
+            if(str == NULL)
+            {
+                return NULL;
+            }
+            
+            const char *backslash = str;
+            while(backslash[-1] == '\\')
+            {
+                backslash--;
+            }
+            
+            if(((str - backslash) & 1) == 0)
+            {
+                return str + 1;
+            }
+        }
+        
+        return NULL;
+    }
+    
+    // just past the value starting at 'str', NULL if it does not end before 'end'. As with jason_SkipContainer, nothing is validated
+    const char *jason_SkipValue(const char *str, const char *end)
+    {
+        if(*str == '{' || *str == '[')
+        {
+            return jason_SkipContainer(str, end);
+        }
+        
+        if(*str == '"')
+        {
+            return jason_SkipString(str, end);
+        }
+        
+        while(str < end && !JASON_ISWHITESPACE(*str) && *str != ',' && *str != '}' && *str != ']')
+        {
+            str++;
+        }
+        
+        return str;
+    }
+    
+    // the projection node under 'node' that a key, or with key NULL an array element, leads to. -1 if none does
+    int32_t jason_ProjectChild(const jasonProjection *projection, int32_t node, const char *key, jasonSize keyLen, jasonSize index)
+    {
+        for(int32_t child = projection->Nodes[node].FirstChild; child >= 0; child = projection->Nodes[child].NextSibling)
+        {
+            const jasonProjectionNode *candidate = projection->Nodes + child;
+            if(candidate->Wildcard)
+            {
+                return child;
+            }
+            
+            if(key != NULL ? (candidate->KeyLen == keyLen && memcmp(projection->Text + candidate->KeyOffset, key, keyLen) == 0) : (candidate->Index == index))
+            {
+                return child;
+            }
+        }
+        
+        return -1;
+    }
+    
+    // with a projection, decide on the key or element about to be parsed. One that no path leads to is passed over
+    // without nodes and the parser carries on at the separator after it. jasonFlag_Strict does not look inside it.
+    // Before the last chunk a key is only decided on once it is whole, *needInput asks for more, and a value passed
+    // over is left to jasonParseState_Skip, which can go on with it in the next chunk
+    jasonStatus jason_Project(jason *jason, jasonFrame *frame, const char **str, const char *strEnd, int32_t isFinal, int32_t *needInput)
+    {
+        const jasonProjection *projection = jason->Projection;
+        int32_t isObject = (*jason->RootValue[frame->Container].Value == '{');
+        const char *skipFrom = *str;
+        int32_t child = -1;
+        
+        if(isObject)
+        {
+            if(frame->NumChildren % 2 == 1 || **str != '"')
+            {
+                // the value of a kept key, or not a key at all and the parser reports it
+                return jasonStatus_Continue;
+            }
+            
+            const char *keyEnd = jason_SkipString(*str, strEnd);
+            if(keyEnd == NULL)
+            {
+                *needInput = !isFinal;
+                return jasonStatus_Continue;
+            }
+            
+            child = jason_ProjectChild(projection, frame->Projection, *str + 1, (jasonSize)(keyEnd - *str - 2), 0);
+            if(child < 0)
+            {
+                skipFrom = keyEnd;
+                JASON_SKIPWHITESPACE(skipFrom, strEnd);
+                if(skipFrom >= strEnd || *skipFrom != ':')
+                {
+                    *needInput = !isFinal && skipFrom >= strEnd;
+                    return jasonStatus_Continue;
+                }
+                
+                skipFrom++;
+                JASON_SKIPWHITESPACE(skipFrom, strEnd);
+            }
+        }
+        else
+        {
+            child = jason_ProjectChild(projection, frame->Projection, NULL, 0, frame->NumChildren + frame->Skipped);
+        }
+        
+        if(child >= 0)
+        {
+            frame->Pending = projection->Nodes[child].KeepAll ? -1 : child;
+            return jasonStatus_Continue;
+        }
+        
+        if(!isFinal)
+        {
+            *needInput = (skipFrom >= strEnd);
+            if(!*needInput)
+            {
+                memset(&jason->Skip, 0, sizeof(jasonSkipState));
+                *str = skipFrom;
+                jason->ParseState = jasonParseState_Skip;
+            }
+            
+            return jasonStatus_Continue;
+        }
+        
+        const char *valueEnd = (skipFrom < strEnd) ? jason_SkipValue(skipFrom, strEnd) : NULL;
+        if(valueEnd == NULL || valueEnd == skipFrom)
+        {
+            // leave malformed input to the parser, so it is reported the same way
+            return jasonStatus_Continue;
+        }
+        
+        frame->Skipped++;
+        *str = valueEnd;
+        jason->ParseState = jasonParseState_ValueSeparator;
+        return jasonStatus_Continue;
+    }
+    
+    // 128-bit truncated powers of five from 5^-342 to 5^324, most significant word first. Parsing reads up to
+    // 5^308, writing needs the rest for the smallest subnormals
+    const uint64_t jason_PowersOfFive[] =
+    {
+        0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+        0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL, 0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+        0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+        0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+        0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL, 0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+        0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+        0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+        0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL, 0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+        0x84a57695fe98746dULL, 0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+        0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+        0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL, 0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+        0xfd00b897478238d0ULL, 0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+        0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+        0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL, 0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+        0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+        0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+        0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL, 0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+        0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+        0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+        0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL, 0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+        0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+        0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+        0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL, 0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+        0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+        0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+        0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL, 0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+        0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+        0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+        0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL, 0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+        0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+        0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+        0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL, 0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+        0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+        0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+        0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL, 0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+        0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+        0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+        0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL, 0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+        0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+        0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+        0xc987434744ac874eULL, 0xa327ffb266b56220ULL, 0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+        0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+        0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+        0xc0314325637a1939ULL, 0xfa911155fefb5308ULL, 0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+        0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+        0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+        0xb749faed14125d36ULL, 0xcef980ec671f667bULL, 0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+        0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+        0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+        0xaecc49914078536dULL, 0x58fae9f773886e18ULL, 0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+        0x888f99797a5e012dULL, 0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+        0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+        0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL, 0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+        0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+        0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+        0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL, 0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+        0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+        0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+        0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL, 0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+        0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+        0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+        0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL, 0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+        0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+        0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+        0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL, 0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+        0xd77485cb25823ac7ULL, 0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+        0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+        0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL, 0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+        0xcd795be870516656ULL, 0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+        0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+        0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL, 0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+        0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+        0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+        0xef340a98172aace4ULL, 0x86fb897116c87c34ULL, 0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+        0xbae0a846d2195712ULL, 0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+        0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+        0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL, 0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+        0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+        0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+        0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL, 0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+        0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+        0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+        0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL, 0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+        0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+        0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+        0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL, 0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+        0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+        0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+        0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL, 0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+        0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+        0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+        0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL, 0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+        0x8c974f7383725573ULL, 0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+        0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+        0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL, 0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+        0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+        0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+        0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL, 0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+        0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+        0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+        0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL, 0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+        0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+        0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+        0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL, 0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+        0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+        0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+        0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL, 0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+        0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+        0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+        0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL, 0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+        0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+        0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+        0x811ccc668829b887ULL, 0x0806357d5a3f525fULL, 0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+        0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+        0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+        0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL, 0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+        0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+        0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+        0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL, 0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+        0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+        0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+        0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL, 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+        0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+        0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+        0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL, 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+        0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+        0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+        0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL, 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+        0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+        0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+        0xc24452da229b021bULL, 0xfbe85badce996168ULL, 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+        0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+        0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+        0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL, 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+        0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+        0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+        0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL, 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+        0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+        0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+        0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+        0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+        0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+        0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+        0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+        0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+        0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+        0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+        0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+        0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+        0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+        0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+        0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+        0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+        0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+        0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+        0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+        0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+        0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+        0xc612062576589ddaULL, 0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+        0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+        0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, 0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+        0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+        0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+        0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+        0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+        0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+        0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+        0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+        0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+        0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, 0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+        0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+        0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL, 0x0000000000000000ULL,
+        0xc800000000000000ULL, 0x0000000000000000ULL, 0xfa00000000000000ULL, 0x0000000000000000ULL,
+        0x9c40000000000000ULL, 0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+        0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+        0xbebc200000000000ULL, 0x0000000000000000ULL, 0xee6b280000000000ULL, 0x0000000000000000ULL,
+        0x9502f90000000000ULL, 0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+        0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL, 0x0000000000000000ULL,
+        0xb5e620f480000000ULL, 0x0000000000000000ULL, 0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+        0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+        0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+        0xad78ebc5ac620000ULL, 0x0000000000000000ULL, 0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+        0x878678326eac9000ULL, 0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+        0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL, 0x0000000000000000ULL,
+        0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+        0x813f3978f8940984ULL, 0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+        0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+        0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, 0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+        0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+        0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+        0x96769950b50d88f4ULL, 0x1314448000000000ULL, 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+        0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+        0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+        0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+        0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+        0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+        0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+        0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+        0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+        0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+        0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+        0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+        0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+        0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+        0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+        0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL, 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+        0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+        0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+        0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL, 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+        0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+        0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+        0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL, 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+        0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+        0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+        0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL, 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+        0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+        0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+        0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL, 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+        0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+        0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+        0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL, 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+        0x924d692ca61be758ULL, 0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+        0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+        0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL, 0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+        0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+        0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+        0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL, 0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+        0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+        0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+        0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL, 0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+        0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+        0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+        0x9ae757596946075fULL, 0x3375788de9b06958ULL, 0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+        0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+        0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+        0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL, 0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+        0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+        0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+        0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL, 0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+        0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+        0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+        0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL, 0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+        0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+        0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+        0x802221226be55a64ULL, 0xc2494954da2c9789ULL, 0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+        0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+        0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+        0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL, 0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+        0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+        0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+        0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL, 0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+        0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+        0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+        0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL, 0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+        0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+        0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+        0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL, 0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+        0xa59bc234db398c25ULL, 0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+        0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+        0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL, 0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+        0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+        0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+        0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL, 0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+        0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+        0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+        0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL, 0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+        0x8fa475791a569d10ULL, 0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+        0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+        0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL, 0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+        0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+        0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+        0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL, 0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+        0x82a45b450226b39cULL, 0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+        0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+        0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL, 0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+        0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+        0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+        0x98165af37b2153deULL, 0xc3727a337a8b704aULL, 0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+        0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+        0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+        0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL, 0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+        0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+        0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+        0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL, 0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+        0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+        0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+        0x83ea2b892091e44dULL, 0x934aed0aab460432ULL, 0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+        0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+        0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+        0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL, 0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+        0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+        0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+        0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL, 0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+        0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+        0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+        0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL, 0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+        0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+        0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+        0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL, 0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+        0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+        0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+        0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL, 0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+        0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+        0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+        0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL, 0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+        0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+        0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+        0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL, 0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+        0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+        0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+        0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL, 0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+        0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+        0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+        0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL, 0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+        0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+        0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+        0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL, 0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+        0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+        0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+        0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL, 0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+        0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+        0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+        0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL, 0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+        0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+        0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+        0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL,
+        0xb201833b35d63f73ULL, 0x2cd2cc6551e513daULL, 0xde81e40a034bcf4fULL, 0xf8077f7ea65e58d1ULL,
+        0x8b112e86420f6191ULL, 0xfb04afaf27faf782ULL, 0xadd57a27d29339f6ULL, 0x79c5db9af1f9b563ULL,
+        0xd94ad8b1c7380874ULL, 0x18375281ae7822bcULL, 0x87cec76f1c830548ULL, 0x8f2293910d0b15b5ULL,
+        0xa9c2794ae3a3c69aULL, 0xb2eb3875504ddb22ULL, 0xd433179d9c8cb841ULL, 0x5fa60692a46151ebULL,
+        0x849feec281d7f328ULL, 0xdbc7c41ba6bcd333ULL, 0xa5c7ea73224deff3ULL, 0x12b9b522906c0800ULL,
+        0xcf39e50feae16befULL, 0xd768226b34870a00ULL, 0x81842f29f2cce375ULL, 0xe6a1158300d46640ULL,
+        0xa1e53af46f801c53ULL, 0x60495ae3c1097fd0ULL, 0xca5e89b18b602368ULL, 0x385bb19cb14bdfc4ULL,
+        0xfcf62c1dee382c42ULL, 0x46729e03dd9ed7b5ULL, 0x9e19db92b4e31ba9ULL, 0x6c07a2c26a8346d1ULL
+    };
+    
+    const double jason_PowersOfTen[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    
+    uint64_t jason_Multiply128(uint64_t a, uint64_t b, uint64_t *low)
+    {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = (unsigned __int128)a * b;
+        *low = (uint64_t)product;
+        return (uint64_t)(product >> 64);
+#else
+        uint64_t aLow = (uint32_t)a, aHigh = a >> 32;
+        uint64_t bLow = (uint32_t)b, bHigh = b >> 32;
+        uint64_t lowLow = aLow * bLow;
+        uint64_t highLow = aHigh * bLow;
+        uint64_t lowHigh = aLow * bHigh;
+        uint64_t highHigh = aHigh * bHigh;
+        uint64_t cross = (lowLow >> 32) + (uint32_t)highLow + lowHigh;
+        *low = (cross << 32) | (uint32_t)lowLow;
+        return highHigh + (highLow >> 32) + (cross >> 32);
+#endif
+    }
+    
+    int jason_IsEightDigits(const char *str)
+    {
+        uint64_t val;
+        memcpy(&val, str, sizeof(val));
+        return (((val & 0xF0F0F0F0F0F0F0F0ULL) | (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+    }
+    
+    // SWAR conversion of eight ASCII digits, the first one most significant
+    uint32_t jason_ParseEightDigits(const char *str)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        uint64_t val;
+        memcpy(&val, str, sizeof(val));
+        val = (val & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+        val = (val & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+        return (uint32_t)((val & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+#else
+        uint32_t val = 0;
+        for(int i = 0; i < 8; i++)
+        {
+            val = val * 10 + (uint32_t)(str[i] - '0');
+        }
+        
+        return val;
+#endif
+    }
+    
+    // Eisel-Lemire: the double nearest to w * 10^q, w non-zero and at most 19 digits
+    uint64_t jason_EiselLemire(uint64_t w, int64_t q)
+    {
+        if(q < -342)
+        {
+            return 0;
+        }
+        
+        if(q > 308)
+        {
+            return (uint64_t)0x7FF << 52;
+        }
+        
+        int leadingZeros = 0;
+        while((w & ((uint64_t)1 << 63)) == 0)
+        {
+            w <<= 1;
+            leadingZeros++;
+        }
+        
+        int index = 2 * (int)(q + 342);
+        uint64_t low;
+        uint64_t high = jason_Multiply128(w, jason_PowersOfFive[index], &low);
+        
+        if((high & 0x1FF) == 0x1FF)
+        {
+            // the truncated power might matter, bring in its low word
+            uint64_t secondLow;
+            uint64_t secondHigh = jason_Multiply128(w, jason_PowersOfFive[index + 1], &secondLow);
+            low += secondHigh;
+            if(secondHigh > low)
+            {
+                high++;
+            }
+        }
+        
+        int upperBit = (int)(high >> 63);
+        int shift = upperBit + 64 - 52 - 3;
+        uint64_t mantissa = high >> shift;
+        int32_t power2 = (int32_t)(((152170 + 65536) * q) >> 16) + 63 + upperBit - leadingZeros + 1023;
+        
+        if(power2 <= 0)
+        {
+            // subnormal
+            if(-power2 + 1 >= 64)
+            {
+                return 0;
+            }
+            
+            mantissa >>= -power2 + 1;
+            mantissa += (mantissa & 1);
+            mantissa >>= 1;
+            power2 = (mantissa < ((uint64_t)1 << 52)) ? 0 : 1;
+            return mantissa | ((uint64_t)power2 << 52);
+        }
+        
+        if(low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == high)
+        {
+            // exactly halfway, round to even
+            mantissa &= ~(uint64_t)1;
+        }
+        
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        
+        if(mantissa >= ((uint64_t)2 << 52))
+        {
+            mantissa = (uint64_t)1 << 52;
+            power2++;
+        }
+        
+        mantissa &= ~((uint64_t)1 << 52);
+        
+        if(power2 >= 0x7FF)
+        {
+            return (uint64_t)0x7FF << 52;
+        }
+        
+        return mantissa | ((uint64_t)power2 << 52);
+    }
+    
+    // exact but slow, strtod on a copy with the locale's decimal point
+    double jason_StrToDouble(const char *str, jasonSize len)
+    {
+        char buffer[128];
+        char *copy = buffer;
+        
+        if(len < 0)
+        {
+            return 0;
+        }
+        
+        size_t memLength = (size_t)len + 1;
+        
+        if(memLength > sizeof(buffer))
+        {
+            copy = malloc(memLength);
+            if(copy == NULL)
+            {
+                return 0;
+            }
+        }
+        
+        char decimalPoint = localeconv()->decimal_point[0];
+        for(jasonSize i = 0; i < len; i++)
+        {
+            copy[i] = (str[i] == '.') ? decimalPoint : str[i];
+        }
+        
+        copy[len] = '\0';
+        double result = strtod(copy, NULL);
+        
+        if(copy != buffer)
+        {
+            free(copy);
+        }
+        
+        return result;
+    }
+    
+    double jason_BitsToDouble(uint64_t bits)
+    {
+        double result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+    
+    // strict JSON number grammar, integers that fit 64 bits stay integers
+    jasonStatus jason_ParseNumber(const char *str, jasonSize len, jasonNumber *number)
+    {
+        const char *it = str;
+        const char *end = str + len;
+        int negative = 0;
+        
+        if(it < end && *it == '-')
+        {
+            negative = 1;
+            it++;
+        }
+        
+        const char *intStart = it;
+        uint64_t mantissa = 0;
+        
+        if(it >= end || !JASON_ISDIGIT(*it) || (*it == '0' && it + 1 < end && JASON_ISDIGIT(it[1])))
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        while(end - it >= 8 && jason_IsEightDigits(it))
+        {
+            mantissa = mantissa * 100000000 + jason_ParseEightDigits(it);
+            it += 8;
+        }
+        
+        while(it < end && JASON_ISDIGIT(*it))
+        {
+            mantissa = mantissa * 10 + (uint64_t)(*it - '0');
+            it++;
+        }
+        
+        int64_t intDigits = it - intStart;
+        const char *fracStart = NULL;
+        int64_t fracDigits = 0;
+        int64_t exponent = 0;
+        int hasExponent = 0;
+        
+        if(it < end && *it == '.')
+        {
+            fracStart = ++it;
+            
+            while(end - it >= 8 && jason_IsEightDigits(it))
+            {
+                mantissa = mantissa * 100000000 + jason_ParseEightDigits(it);
+                it += 8;
+            }
+            
+            while(it < end && JASON_ISDIGIT(*it))
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*it - '0');
+                it++;
+            }
+            
+            fracDigits = it - fracStart;
+            if(fracDigits == 0)
+            {
+                return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+            }
+        }
+        
+        if(it < end && (*it == 'e' || *it == 'E'))
+        {
+            int negativeExponent = 0;
+            hasExponent = 1;
+            it++;
+            
+            if(it < end && (*it == '-' || *it == '+'))
+            {
+                negativeExponent = (*it == '-');
+                it++;
+            }
+            
+            if(it >= end || !JASON_ISDIGIT(*it))
+            {
+                return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+            }
+            
+            while(it < end && JASON_ISDIGIT(*it))
+            {
+                if(exponent < 0x10000000)
+                {
+                    exponent = exponent * 10 + (*it - '0');
+                }
+                
+                it++;
+            }
+            
+            exponent = negativeExponent ? -exponent : exponent;
+        }
+        
+        if(it != end)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        if(fracStart == NULL && !hasExponent)
+        {
+            if(intDigits < 20)
+            {
+                if(!negative && mantissa <= (uint64_t)INT64_MAX)
+                {
+                    number->Type = jasonNumberType_Int64;
+                    number->Int64 = (int64_t)mantissa;
+                    return jasonStatus_Finished;
+                }
+                
+                if(!negative)
+                {
+                    number->Type = jasonNumberType_Uint64;
+                    number->Uint64 = mantissa;
+                    return jasonStatus_Finished;
+                }
+                
+                if(mantissa <= (uint64_t)INT64_MAX + 1)
+                {
+                    number->Type = jasonNumberType_Int64;
+                    number->Int64 = (mantissa == (uint64_t)INT64_MAX + 1) ? INT64_MIN : -(int64_t)mantissa;
+                    return jasonStatus_Finished;
+                }
+            }
+            else if(intDigits == 20 && !negative && intStart[0] == '1')
+            {
+                // may still fit an unsigned 64-bit integer
+                uint64_t value = 0;
+                int overflow = 0;
+                for(const char *digit = intStart; digit < end; digit++)
+                {
+                    uint64_t d = (uint64_t)(*digit - '0');
+                    overflow |= (value > (UINT64_MAX - d) / 10);
+                    value = value * 10 + d;
+                }
+                
+                if(!overflow)
+                {
+                    number->Type = jasonNumberType_Uint64;
+                    number->Uint64 = value;
+                    return jasonStatus_Finished;
+                }
+            }
+            
+            number->Type = jasonNumberType_BigInteger;
+        }
+        else
+        {
+            number->Type = jasonNumberType_Double;
+        }
+        
+        // significant digits, dropping the leading zeros of numbers like 0.000123
+        int64_t digits = intDigits + fracDigits;
+        const char *first = intStart;
+        while(digits > 0 && (*first == '0' || *first == '.'))
+        {
+            digits -= (*first == '0');
+            first++;
+        }
+        
+        int truncated = 0;
+        exponent -= fracDigits;
+        
+        if(digits > 19)
+        {
+            // keep the first 19 significant digits and remember whether anything was dropped
+            int64_t taken = 0;
+            int64_t skippedIntDigits = 0;
+            int64_t takenFracDigits = 0;
+            mantissa = 0;
+            
+            for(const char *digit = first; digit < intStart + intDigits + (fracStart ? 1 + fracDigits : 0); digit++)
+            {
+                if(*digit == '.')
+                {
+                    continue;
+                }
+                
+                int inFraction = (fracStart != NULL && digit >= fracStart);
+                if(taken < 19)
+                {
+                    mantissa = mantissa * 10 + (uint64_t)(*digit - '0');
+                    taken++;
+                    takenFracDigits = inFraction ? (digit - fracStart) + 1 : 0;
+                }
+                else
+                {
+                    skippedIntDigits += !inFraction;
+                    truncated |= (*digit != '0');
+                }
+            }
+            
+            exponent += fracDigits + skippedIntDigits - takenFracDigits;
+        }
+        
+        double result;
+        if(mantissa == 0)
+        {
+            result = 0;
+        }
+        else if(!truncated && exponent >= -22 && exponent <= 22 && mantissa <= ((uint64_t)1 << 53))
+        {
+            // both operands are exact, so is the correctly rounded product
+            result = (double)mantissa;
+            result = (exponent < 0) ? result / jason_PowersOfTen[-exponent] : result * jason_PowersOfTen[exponent];
+        }
+        else
+        {
+            uint64_t bits = jason_EiselLemire(mantissa, exponent);
+            if(truncated && bits != jason_EiselLemire(mantissa + 1, exponent))
+            {
+                // the dropped digits decide the rounding
+                result = jason_StrToDouble(str, len);
+                negative = 0;
+            }
+            else
+            {
+                result = jason_BitsToDouble(bits);
+            }
+        }
+        
+        number->Double = negative ? -result : result;
+        return jasonStatus_Finished;
+    }
+    
+    jasonStatus jasonNumber_GetInt64(const jasonNumber *number, int64_t *out)
+    {
+        switch(number->Type)
+        {
+            case jasonNumberType_Int64:
+                *out = number->Int64;
+                return jasonStatus_Finished;
+                
+            case jasonNumberType_Uint64:
+            case jasonNumberType_BigInteger:
+                return jasonStatus_Break(jasonStatus_IntegerOverflow);
+                
+            default:
+                return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+    }
+    
+    jasonStatus jasonNumber_GetUint64(const jasonNumber *number, uint64_t *out)
+    {
+        switch(number->Type)
+        {
+            case jasonNumberType_Int64:
+                if(number->Int64 < 0)
+                {
+                    return jasonStatus_Break(jasonStatus_IntegerOverflow);
+                }
+                
+                *out = (uint64_t)number->Int64;
+                return jasonStatus_Finished;
+                
+            case jasonNumberType_Uint64:
+                *out = number->Uint64;
+                return jasonStatus_Finished;
+                
+            case jasonNumberType_BigInteger:
+                return jasonStatus_Break(jasonStatus_IntegerOverflow);
+                
+            default:
+                return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+    }
+    
+    jasonStatus jasonNumber_GetDouble(const jasonNumber *number, double *out)
+    {
+        switch(number->Type)
+        {
+            case jasonNumberType_Int64:
+                *out = (double)number->Int64;
+                break;
+                
+            case jasonNumberType_Uint64:
+                *out = (double)number->Uint64;
+                break;
+                
+            default:
+                *out = number->Double;
+                break;
+        }
+        
+        return jasonStatus_Finished;
+    }
+    
+    jasonStatus jasonValue_GetNumber(jasonValue *value, jasonNumber *number)
+    {
+        if(jasonValue_GetType(value) != jasonValueType_Number)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        return jason_ParseNumber(value->Value, value->ValueLen, number);
+    }
+    
+    jasonStatus jasonValue_GetInt64(jasonValue *value, int64_t *out)
+    {
+        jasonNumber number;
+        jasonStatus status = jasonValue_GetNumber(value, &number);
+        return (status == jasonStatus_Finished) ? jasonNumber_GetInt64(&number, out) : status;
+    }
+    
+    jasonStatus jasonValue_GetUint64(jasonValue *value, uint64_t *out)
+    {
+        jasonNumber number;
+        jasonStatus status = jasonValue_GetNumber(value, &number);
+        return (status == jasonStatus_Finished) ? jasonNumber_GetUint64(&number, out) : status;
+    }
+    
+    jasonStatus jasonValue_GetDouble(jasonValue *value, double *out)
+    {
+        jasonNumber number;
+        jasonStatus status = jasonValue_GetNumber(value, &number);
+        return (status == jasonStatus_Finished) ? jasonNumber_GetDouble(&number, out) : status;
+    }
+    
+    // like jasonValue_GetNumber, but uses the numbers decoded during the parse when there are any
+    jasonStatus jason_GetNumber(jason *jason, jasonValue *value, jasonNumber *number)
+    {
+        // values from containers expanded by jasonFlag_Lazy are not on this tape
+        if(jason->Numbers != NULL && (jason->Flags & jasonFlag_DecodeNumbers) && value >= jason->RootValue && value < jason->RootValue + jason->NumValues && jasonValue_GetType(value) == jasonValueType_Number)
+        {
+            *number = jason->Numbers[value - jason->RootValue];
+            return jasonStatus_Finished;
+        }
+        
+        return jasonValue_GetNumber(value, number);
+    }
+    
+    jasonStatus jason_GetInt64(jason *jason, jasonValue *value, int64_t *out)
+    {
+        jasonNumber number;
+        jasonStatus status = jason_GetNumber(jason, value, &number);
+        return (status == jasonStatus_Finished) ? jasonNumber_GetInt64(&number, out) : status;
+    }
+    
+    jasonStatus jason_GetUint64(jason *jason, jasonValue *value, uint64_t *out)
+    {
+        jasonNumber number;
+        jasonStatus status = jason_GetNumber(jason, value, &number);
+        return (status == jasonStatus_Finished) ? jasonNumber_GetUint64(&number, out) : status;
+    }
+    
+    jasonStatus jason_GetDouble(jason *jason, jasonValue *value, double *out)
+    {
+        jasonNumber number;
+        jasonStatus status = jason_GetNumber(jason, value, &number);
+        return (status == jasonStatus_Finished) ? jasonNumber_GetDouble(&number, out) : status;
+    }
+    
+    // make room for at least numValues values without disturbing the ones already parsed
+    jasonStatus jason_ResizeTape(jason *jason, jasonSize numValues)
+    {
+        size_t minMemLength = (size_t)jason->NumValues * sizeof(jasonValue) + sizeof(jasonValue);
+        size_t memLength = (size_t)numValues * sizeof(jasonValue);
+        jasonValue *newRoot = NULL;
+        
+        if(jason->RootValue == NULL)
+        {
+            newRoot = jason->Malloc(&memLength);
+        }
+        else if(jason->Realloc != NULL)
+        {
+            newRoot = jason->Realloc(jason->RootValue, &memLength);
+        }
+        else
+        {
+            newRoot = jason->Malloc(&memLength);
+            if(newRoot != NULL)
+            {
+                memcpy(newRoot, jason->RootValue, jason->NumValues * sizeof(jasonValue));
+                jason->Free(jason->RootValue);
+            }
+        }
+        
+        if(newRoot == NULL || memLength < minMemLength)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        if(jason->NumValues > 0)
+        {
+            JASON_STATS_ADD(jason, TapeResizes, 1);
+        }
+        
+        jason->RootValue = newRoot;
+        jason->MaxValues = (jasonSize)(memLength / sizeof(jasonValue) < JASON_SIZE_MAX ? memLength / sizeof(jasonValue) : JASON_SIZE_MAX);
+        
+        return jasonStatus_Continue;
+    }
+    
+    // make room for at least numValues values without disturbing the ones already parsed
+    jasonStatus jason_ReserveValues(jason *jason, jasonSize numValues)
+    {
+        if(numValues > jason->MaxValues || jason->RootValue == NULL)
+        {
+            jasonStatus status = jason_ResizeTape(jason, numValues);
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+        }
+        
+        if(jason->Flags & jasonFlag_DecodeNumbers)
+        {
+            return jason_GrowBuffer(jason, (void**)&jason->Numbers, &jason->NumbersSize, (size_t)jason->MaxValues * sizeof(jasonNumber));
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    jasonStatus jason_GrowTape(jason *jason)
+    {
+        if(jason->MaxValues == JASON_SIZE_MAX)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        return jason_ReserveValues(jason, jason->MaxValues > JASON_SIZE_MAX / 2 ? JASON_SIZE_MAX : jason->MaxValues * 2);
+    }
+    
+    // the end of the longest number at str that the grammar of RFC 8259 allows (an optional minus, an integer part without
+    // leading zeros, then an optional fraction and exponent that each have at least one digit), str itself for none.
+    // Whatever follows is left for the value separator to reject. *stop is where reading stopped, end when the number
+    // could go on in more input
+    const char *jason_ScanNumber(const char *str, const char *end, const char **stop)
+    {
+        const char *it = str;
+        const char *valid = str;
+        
+        if(it < end && *it == '-')
+        {
+            it++;
+        }
+        
+        if(it < end && *it == '0')
+        {
+            valid = ++it;
+        }
+        else if(it < end && *it >= '1' && *it <= '9')
+        {
+            while(it < end && JASON_ISDIGIT(*it))
+            {
+                it++;
+            }
+            
+            valid = it;
+        }
+        else
+        {
+            *stop = it;
+            return str;
+        }
+        
+        if(it < end && *it == '.')
+        {
+            const char *digits = ++it;
+            while(it < end && JASON_ISDIGIT(*it))
+            {
+                it++;
+            }
+            
+            if(it == digits)
+            {
+                *stop = it;
+                return valid;
+            }
+            
+            valid = it;
+        }
+        
+        if(it < end && (*it == 'e' || *it == 'E'))
+        {
+            it++;
+            if(it < end && (*it == '+' || *it == '-'))
+            {
+                it++;
+            }
+            
+            const char *digits = it;
+            while(it < end && JASON_ISDIGIT(*it))
+            {
+                it++;
+            }
+            
+            if(it > digits)
+            {
+                valid = it;
+            }
+        }
+        
+        *stop = it;
+        return valid;
+    }
+    
+    // the length of the escape RFC 8259 allows at the backslash str points to, 0 for none. The caller makes sure the
+    // six characters of a \u escape are there
+    int32_t jason_CheckEscape(const char *str)
+    {
+        switch(str[1])
+        {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                return 2;
+                
+            case 'u':
+                return (isxdigit((unsigned char)str[2]) && isxdigit((unsigned char)str[3]) && isxdigit((unsigned char)str[4]) && isxdigit((unsigned char)str[5])) ? 6 : 0;
+                
+            default:
+                return 0;
+        }
+    }
+    
+    // every backslash in a complete string's characters starts one of the escapes RFC 8259 allows
+    int32_t jason_CheckEscapes(const char *str, jasonSize len)
+    {
+        const char *end = str + len;
+        for(const char *it = memchr(str, '\\', len); it != NULL; it = memchr(it, '\\', end - it))
+        {
+            // the closing quote follows a string's last backslash, so there is always a character after one
+            int32_t escapeLen = (it[1] == 'u' && end - it < 6) ? 0 : jason_CheckEscape(it);
+            if(escapeLen == 0)
+            {
+                return 0;
+            }
+            
+            it += escapeLen;
+        }
+        
+        return 1;
+    }
+    
+    // the string scan of jason_DeserializeStep for jasonFlag_Strict, which checks escapes and control characters on the
+    // way and sets *checkUtf8 at the first byte above 0x7F, leaving the UTF-8 for when the string is complete. Eight
+    // plain characters are skipped at a time. *str is left on the closing quote, at an escape still waiting for input,
+    // or on the character that breaks the grammar
+    jasonStatus jason_ScanStrictString(jasonValue *val, const char **str, const char *strEnd, int32_t *checkUtf8)
+    {
+        const char *it = *str;
+        jasonStatus status = jasonStatus_Continue;
+        
+        while(it < strEnd)
+        {
+            if(strEnd - it >= 8)
+            {
+                // a quote or backslash turns a byte of these to zero, which sets its high bit like a control character
+                // or a byte above 0x7F does
+                uint64_t word;
+                memcpy(&word, it, sizeof(word));
+                uint64_t quotes = word ^ 0x2222222222222222ull;
+                uint64_t backslashes = word ^ 0x5C5C5C5C5C5C5C5Cull;
+                uint64_t found = word | (word - 0x2020202020202020ull) | (quotes - 0x0101010101010101ull) | (backslashes - 0x0101010101010101ull);
+                found &= 0x8080808080808080ull;
+                if(found == 0)
+                {
+                    it += 8;
+                    continue;
+                }
+                
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                // borrows only carry upwards, so the lowest byte set is the first one to look at
+                it += jason_CountTrailingZeros(found) >> 3;
+#endif
+            }
+            
+            unsigned char c = (unsigned char)*it;
+            if(c == '"')
+            {
+                break;
+            }
+            
+            if(c == '\\')
+            {
+                if(strEnd - it < 2 || (it[1] == 'u' && strEnd - it < 6))
+                {
+                    // look at the escape once all of it arrives
+                    break;
+                }
+                
+                int32_t escapeLen = jason_CheckEscape(it);
+                if(escapeLen == 0)
+                {
+                    status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    break;
+                }
+                
+                // the flag lives in the value so it survives a pause between chunks
+                val->ValueLen = JASON_STRING_ESCAPED;
+                it += escapeLen;
+                continue;
+            }
+            
+            if(c < 0x20)
+            {
+                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                break;
+            }
+            
+            *checkUtf8 |= (c >= 0x80);
+            it++;
+        }
+        
+        *str = it;
+        return status;
+    }
+    
+    // cheap upper bound on the number of values in a document, every value but the root follows one of these
+    jasonSize jason_CountValues(const char *json, jasonSize jsonLen)
+    {
+        int64_t count = 1;
+        for(jasonSize i = 0; i < jsonLen; i++)
+        {
+            char c = json[i];
+            count += (c == ',') | (c == ':') | (c == '[') | (c == '{');
+        }
+        
+        return count < JASON_SIZE_MAX ? (jasonSize)count : JASON_SIZE_MAX;
+    }
+    
+    jasonStatus jason_PushFrame(jason *jason, jasonSize container)
+    {
+        int32_t maxDepth = jason->MaxDepth > 0 ? jason->MaxDepth : JASON_DEFAULT_MAX_DEPTH;
+        
+        if(jason->Depth >= maxDepth)
+        {
+            return jasonStatus_Break(jasonStatus_MaxDepthExceeded);
+        }
+        
+        if(jason->Depth >= jason->StackSize)
+        {
+            if(jason->Stack != NULL && !jason->OwnsStack)
+            {
+                // caller-sized stack is full
+                return jasonStatus_Break(jasonStatus_MaxDepthExceeded);
+            }
+            
+            int32_t newStackSize = jason->StackSize > 0 ? jason->StackSize * 2 : 16;
+            if(newStackSize > maxDepth)
+            {
+                newStackSize = maxDepth;
+            }
+            
+            size_t memLength = newStackSize * sizeof(jasonFrame);
+            jasonFrame *newStack = jason->Malloc(&memLength);
+            
+            if(newStack == NULL || memLength < newStackSize * sizeof(jasonFrame))
+            {
+                jason->Free(newStack);
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            if(jason->Stack != NULL)
+            {
+                memcpy(newStack, jason->Stack, jason->Depth * sizeof(jasonFrame));
+                jason->Free(jason->Stack);
+            }
+            
+            jason->Stack = newStack;
+            jason->StackSize = newStackSize;
+            jason->OwnsStack = 1;
+        }
+        
+        int32_t projection = -1;
+        if(jason->Depth > 0)
+        {
+            projection = jason->Stack[jason->Depth - 1].Pending;
+        }
+        else if(jason->Projection != NULL && jason->Projection->NumNodes > 0 && !jason->Projection->Nodes[0].KeepAll)
+        {
+            projection = 0;
+        }
+        
+        jasonFrame *frame = jason->Stack + jason->Depth++;
+        frame->Container = container;
+        frame->Last = 0;
+        frame->LastKey = 0;
+        frame->NumChildren = 0;
+        frame->Skipped = 0;
+        frame->Projection = projection;
+        frame->Pending = -1;
+        frame->Separated = 0;
+        
+        return jasonStatus_Continue;
+    }
+    
+    // attach a finished value to its container and work out what comes next
+    jasonStatus jason_CompleteValue(jason *jason, jasonSize valIndex, const char **str)
+    {
+        JASON_STATS_VALUE(jason, jason->RootValue + valIndex);
+        
+        if(jason->Depth == 0)
+        {
+            jason->ParseState = jasonParseState_Done;
+            return jasonStatus_Continue;
+        }
+        
+        jasonFrame *frame = jason->Stack + (jason->Depth - 1);
+        jasonValue *container = jason->RootValue + frame->Container;
+        jasonValue *child = jason->RootValue + valIndex;
+        
+        // a container's length is the number of values directly inside it, keys included
+        container->ValueLen = ++frame->NumChildren;
+        
+        if(*container->Value == '{' && frame->NumChildren % 2 == 1)
+        {
+            if(*child->Value != '"')
+            {
+                *str = child->Value;
+                return jasonStatus_Break(jasonStatus_ExpectedObjectKey);
+            }
+            
+            if(frame->LastKey != 0)
+            {
+                JASON_SETOFFSET(jason->RootValue[frame->LastKey].Next, valIndex - frame->LastKey);
+            }
+            
+            frame->LastKey = valIndex;
+            jason->ParseState = jasonParseState_KeySeparator;
+            return jasonStatus_Continue;
+        }
+        
+        if(frame->Last != 0)
+        {
+            JASON_SETOFFSET(jason->RootValue[frame->Last].Next, valIndex - frame->Last);
+        }
+        
+        frame->Last = valIndex;
+        jason->ParseState = jasonParseState_ValueSeparator;
+        return jasonStatus_Continue;
+    }
+    
+    // pop the innermost container, its closing character has been consumed
+    jasonStatus jason_CloseContainer(jason *jason, const char **str)
+    {
+        jasonFrame *frame = jason->Stack + --jason->Depth;
+        
+        if(*jason->RootValue[frame->Container].Value == '{' && frame->NumChildren / 2 > JASON_LINEAR_SCAN_KEYS)
+        {
+            jasonStatus status = jason_IndexObject(jason, frame->Container, frame->NumChildren / 2);
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+        }
+        
+        return jason_CompleteValue(jason, frame->Container, str);
+    }
+    
+    jasonStatus jason_DeserializeStep(jason *jason, const char *strEnd, int32_t isFinal)
+    {
+        const char *str = jason->ParsePosition;
+        jasonStatus status = jasonStatus_Continue;
+        int32_t needInput = 0;
+        
+        while(status == jasonStatus_Continue && !needInput)
+        {
+            switch(jason->ParseState)
+            {
+                case jasonParseState_Value:
+                {
+                    JASON_SKIPTOTOKEN(jason, str, strEnd);
+                    
+                    if(str >= strEnd)
+                    {
+                        needInput = 1;
+                        break;
+                    }
+                    
+                    if((*str == '}' || *str == ']') && jason->Depth > 0)
+                    {
+                        // straight after the opening bracket or a comma
+                        jasonFrame *frame = jason->Stack + (jason->Depth - 1);
+                        char opener = *jason->RootValue[frame->Container].Value;
+                        if(((opener == '[' && *str == ']') || (opener == '{' && *str == '}' && frame->NumChildren % 2 == 0)) && !(frame->Separated && (jason->Flags & jasonFlag_Strict)))
+                        {
+                            str++;
+                            status = jason_CloseContainer(jason, &str);
+                            break;
+                        }
+                    }
+                    
+                    if(jason->Depth > 0 && jason->Stack[jason->Depth - 1].Projection >= 0)
+                    {
+                        jason_Project(jason, jason->Stack + (jason->Depth - 1), &str, strEnd, isFinal, &needInput);
+                        if(needInput || jason->ParseState != jasonParseState_Value)
+                        {
+                            break;
+                        }
+                    }
+                    
+                    if(jason->NumValues >= jason->MaxValues)
+                    {
+                        status = jason_GrowTape(jason);
+                        if(status != jasonStatus_Continue)
+                        {
+                            break;
+                        }
+                    }
+                    
+                    jasonSize valIndex = jason->NumValues++;
+                    jasonValue *val = jason->RootValue + valIndex;
+                    val->Value = str;
+                    val->ValueLen = 0;
+                    val->Next = 0;
+                    
+                    switch(*str)
+                    {
+                        case '{':
+                        case '[':
+                            if((jason->Flags & jasonFlag_Lazy) && jason->Depth > 0 && jason->Stack[jason->Depth - 1].Pending < 0)
+                            {
+                                // only the outermost container gets nodes, the ones inside are passed over until used,
+                                // unless a projection still has to pick values out of them. One that runs on past the
+                                // input so far gets nodes too, when more is to come
+                                const char *end = jason_SkipContainer(str, strEnd);
+                                if(end != NULL && (jason->Flags & jasonFlag_Strict))
+                                {
+                                    // checked all the same, without nodes or callbacks
+                                    jasonSaxHandler checker;
+                                    memset(&checker, 0, sizeof(checker));
+                                    checker.Flags = jasonFlag_Strict;
+                                    status = jason_DeserializeSax(&checker, str, (jasonSize)(end - str));
+                                    if(status != jasonStatus_Finished)
+                                    {
+                                        str = checker.Position;
+                                        break;
+                                    }
+                                    
+                                    status = jasonStatus_Continue;
+                                }
+                                
+                                if(end != NULL)
+                                {
+                                    JASON_SETOFFSET(val->ValueLen, -(end - str));
+                                    str = end;
+                                    status = jason_CompleteValue(jason, valIndex, &str);
+                                    break;
+                                }
+                                
+                                if(isFinal)
+                                {
+                                    status = jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+                                    break;
+                                }
+                            }
+                            
+                            str++;
+                            status = jason_PushFrame(jason, valIndex);
+                            break;
+                            
+                        case '"':
+                            str++;
+                            jason->ParseState = jasonParseState_String;
+                            break;
+                            
+                        case 't':
+                        case 'f':
+                        case 'n':
+                            jason->ParseState = jasonParseState_Literal;
+                            break;
+                            
+                        default:
+                            if(!JASON_ISDIGIT(*str) && *str != '-')
+                            {
+                                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                                break;
+                            }
+                            
+                            jason->ParseState = jasonParseState_Number;
+                            break;
+                    }
+                    
+                    break;
+                }
+                    
+                case jasonParseState_String:
+                {
+                    jasonValue *val = jason->RootValue + (jason->NumValues - 1);
+                    int32_t isIndexed = (jason->StructuralIndex.Positions != NULL);
+                    int32_t checkUtf8 = 0;
+                    
+                    if(isIndexed)
+                    {
+                        // the closing quote is the next indexed position after the opening one
+                        str = jason_NextStructural(jason, str - 1);
+                        if(str < strEnd && memchr(val->Value + 1, '\\', str - val->Value - 1) != NULL)
+                        {
+                            val->ValueLen = JASON_STRING_ESCAPED;
+                        }
+                        
+                        checkUtf8 = (jason->Flags & jasonFlag_Strict) != 0;
+                    }
+                    else if(jason->Flags & jasonFlag_Strict)
+                    {
+                        // a string resumed in a later chunk has its UTF-8 checked whole
+                        checkUtf8 = (str != val->Value + 1);
+                        status = jason_ScanStrictString(val, &str, strEnd, &checkUtf8);
+                        if(status != jasonStatus_Continue)
+                        {
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        while(str < strEnd && *str != '"')
+                        {
+                            if(*str == '\\')
+                            {
+                                if(str + 1 >= strEnd)
+                                {
+                                    // look at the escaped character once it arrives
+                                    break;
+                                }
+                                
+                                // the flag lives in the value so it survives a pause between chunks
+                                val->ValueLen = JASON_STRING_ESCAPED;
+                                str++;
+                            }
+                            
+                            str++;
+                        }
+                    }
+                    
+                    if(str >= strEnd || *str != '"')
+                    {
+                        needInput = 1;
+                        break;
+                    }
+                    
+                    jasonSize escaped = val->ValueLen & JASON_STRING_ESCAPED;
+                    if(checkUtf8)
+                    {
+                        const char *chars = val->Value + 1;
+                        if(!jason_SelectStringChecker()(chars, str - chars) || (isIndexed && escaped && !jason_CheckEscapes(chars, str - chars)))
+                        {
+                            // left on the closing quote, so feeding more input fails the same way
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                    }
+                    
+                    str++;
+                    JASON_SETOFFSET(val->ValueLen, str - val->Value);
+                    if(val->ValueLen > JASON_VALUELEN_MASK)
+                    {
+                        return jasonStatus_Break(jasonStatus_IntegerOverflow);
+                    }
+                    
+                    val->ValueLen |= escaped;
+                    status = jason_CompleteValue(jason, jason->NumValues - 1, &str);
+                    break;
+                }
+                    
+                case jasonParseState_Literal:
+                {
+                    jasonValue *val = jason->RootValue + (jason->NumValues - 1);
+                    const char *literal = (*val->Value == 't') ? "true" : (*val->Value == 'f') ? "false" : "null";
+                    int32_t literalLen = (int32_t)strlen(literal);
+                    int32_t available = (strEnd - val->Value < literalLen) ? (int32_t)(strEnd - val->Value) : literalLen;
+                    
+                    if(strncmp(val->Value, literal, available) != 0)
+                    {
+                        str = val->Value;
+                        status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                        break;
+                    }
+                    
+                    if(available < literalLen)
+                    {
+                        str = strEnd;
+                        needInput = 1;
+                        break;
+                    }
+                    
+                    val->ValueLen = literalLen;
+                    str = val->Value + literalLen;
+                    status = jason_CompleteValue(jason, jason->NumValues - 1, &str);
+                    break;
+                }
+                    
+                case jasonParseState_Number:
+                {
+                    jasonValue *val = jason->RootValue + (jason->NumValues - 1);
+                    
+                    if(jason->Flags & jasonFlag_Strict)
+                    {
+                        const char *stop = NULL;
+                        const char *numberEnd = jason_ScanNumber(val->Value, strEnd, &stop);
+                        if(stop >= strEnd && !isFinal)
+                        {
+                            // scanned again from its start once more input arrives
+                            str = val->Value;
+                            needInput = 1;
+                            break;
+                        }
+                        
+                        if(numberEnd == val->Value)
+                        {
+                            str = stop;
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                        
+                        str = numberEnd;
+                    }
+                    else
+                    {
+                        while(str < strEnd && (JASON_ISDIGIT(*str) || *str == '.' || *str == 'E' || *str == 'e' || *str == '-' || *str == '+'))
+                        {
+                            str++;
+                        }
+                        
+                        if(str >= strEnd && !isFinal)
+                        {
+                            needInput = 1;
+                            break;
+                        }
+                        
+                        if(!JASON_ISDIGIT(str[-1]))
+                        {
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                    }
+                    
+                    JASON_SETOFFSET(val->ValueLen, str - val->Value);
+                    
+                    if(jason->Flags & jasonFlag_DecodeNumbers)
+                    {
+                        if(jason_ParseNumber(val->Value, val->ValueLen, jason->Numbers + (jason->NumValues - 1)) != jasonStatus_Finished)
+                        {
+                            str = val->Value;
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                    }
+                    
+                    status = jason_CompleteValue(jason, jason->NumValues - 1, &str);
+                    break;
+                }
+                    
+                case jasonParseState_KeySeparator:
+                {
+                    JASON_SKIPTOTOKEN(jason, str, strEnd);
+                    
+                    if(str >= strEnd)
+                    {
+                        needInput = 1;
+                    }
+                    else if(*str != ':')
+                    {
+                        status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    }
+                    else
+                    {
+                        str++;
+                        jason->ParseState = jasonParseState_Value;
+                    }
+                    
+                    break;
+                }
+                    
+                case jasonParseState_ValueSeparator:
+                {
+                    JASON_SKIPTOTOKEN(jason, str, strEnd);
+                    
+                    if(str >= strEnd)
+                    {
+                        needInput = 1;
+                        break;
+                    }
+                    
+                    char opener = *jason->RootValue[jason->Stack[jason->Depth - 1].Container].Value;
+                    
+                    if(*str == ',')
+                    {
+                        str++;
+                        jason->Stack[jason->Depth - 1].Separated = 1;
+                        jason->ParseState = jasonParseState_Value;
+                    }
+                    else if((opener == '{' && *str == '}') || (opener == '[' && *str == ']'))
+                    {
+                        str++;
+                        status = jason_CloseContainer(jason, &str);
+                    }
+                    else
+                    {
+                        status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    }
+                    
+                    break;
+                }
+                    
+                case jasonParseState_Skip:
+                {
+                    // a container goes on from the last whole block it was scanned to, anything else is scanned again
+                    // from its start. Like jason_SkipValue, nothing is validated but the end
+                    if(str >= strEnd)
+                    {
+                        needInput = 1;
+                        break;
+                    }
+                    
+                    const char *resume = str;
+                    const char *end = NULL;
+                    if(jason->Skip.Depth > 0 || *str == '{' || *str == '[')
+                    {
+                        end = jason_SkipContainerFrom(str, strEnd, &jason->Skip, &resume);
+                    }
+                    else
+                    {
+                        end = jason_SkipValue(str, strEnd);
+                        if(end == str)
+                        {
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                        
+                        // a number or literal running up to the end of the chunk may go on in the next one
+                        end = (end == strEnd && *str != '"' && !isFinal) ? NULL : end;
+                    }
+                    
+                    if(end == NULL)
+                    {
+                        str = resume;
+                        needInput = 1;
+                        break;
+                    }
+                    
+                    jason->Stack[jason->Depth - 1].Skipped++;
+                    str = end;
+                    jason->ParseState = jasonParseState_ValueSeparator;
+                    break;
+                }
+                    
+                case jasonParseState_Done:
+                {
+                    JASON_SKIPTOTOKEN(jason, str, strEnd);
+                    
+                    if(str < strEnd)
+                    {
+                        status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    }
+                    else if(isFinal)
+                    {
+                        status = jasonStatus_Finished;
+                    }
+                    else
+                    {
+                        needInput = 1;
+                    }
+                    
+                    break;
+                }
+            }
+        }
+        
+        if(needInput && isFinal)
+        {
+            status = jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        jason->ParsePosition = str;
+        return status;
+    }
+    
+    void jason_ReleaseFile(jason *jason)
+    {
+        if(jason->File == NULL)
+        {
+            return;
+        }
+        
+#ifdef JASON_MMAP
+        if(jason->FileMapped)
+        {
+            munmap(jason->File, jason->FileSize);
+        }
+        else
+#endif
+        {
+            jason->Free(jason->File);
+        }
+        
+        jason->File = NULL;
+        jason->FileSize = 0;
+        jason->FileMapped = 0;
+    }
+    
+    void jason_FreeIndexes(jason *jason)
+    {
+        while(jason->Indexes != NULL)
+        {
+            jasonValueIndex *next = jason->Indexes->Next;
+            jason->Free(jason->Indexes);
+            jason->Indexes = next;
+        }
+    }
+    
+    void jason_Cleanup(jason *jason)
+    {
+        jason->Free(jason->StructuralIndex.Positions);
+        jason->StructuralIndex.Positions = NULL;
+        jason->Free(jason->RootValue);
+        jason->Free(jason->KeyLookupTable.Directory);
+        jason->Free(jason->KeyLookupTable.Slots);
+        jason->Free(jason->Numbers);
+        jason->Numbers = NULL;
+        jason->NumbersSize = 0;
+        jason->Free(jason->Digests);
+        jason->Digests = NULL;
+        jason->DigestsSize = 0;
+        jason->NumDigests = 0;
+        jason_FreeIndexes(jason);
+        
+        if(jason->OwnsStack)
+        {
+            jason->Free(jason->Stack);
+            jason->Stack = NULL;
+            jason->StackSize = 0;
+            jason->OwnsStack = 0;
+        }
+        
+        while(jason->SourceBlocks != NULL)
+        {
+            jasonSourceBlock *prev = jason->SourceBlocks->Prev;
+            jason->Free(jason->SourceBlocks);
+            jason->SourceBlocks = prev;
+        }
+        
+        for(int32_t i = 0; i < jason->ExpansionsSize; i++)
+        {
+            if(jason->Expansions[i] != NULL)
+            {
+                jason_Cleanup(&jason->Expansions[i]->Document);
+                jason->Free(jason->Expansions[i]);
+            }
+        }
+        
+        jason->Free(jason->Expansions);
+        jason->Expansions = NULL;
+        jason->ExpansionsSize = 0;
+        jason->NumExpansions = 0;
+        
+        jason_ReleaseFile(jason);
+        jason->RootValue = NULL;
+        memset(&jason->KeyLookupTable, 0, sizeof(jasonHashTable));
+        jason->MaxValues = 0;
+        jason->NumValues = 0;
+    }
+    
+    // forget the parsed document but keep its memory for the next one
+    void jason_Reset(jason *jason)
+    {
+        jason->NumValues = 0;
+        jason->Depth = 0;
+        jason->ParseState = jasonParseState_Value;
+        jason->ParsePosition = NULL;
+        
+        if(jason->KeyLookupTable.Directory != NULL)
+        {
+            memset(jason->KeyLookupTable.Directory, 0, jason->KeyLookupTable.DirectorySize * sizeof(jasonObjectIndex));
+        }
+        
+        jason->KeyLookupTable.NumIndexed = 0;
+        jason->KeyLookupTable.SlotsUsed = 0;
+        jason->NumDigests = 0;
+        jason_FreeIndexes(jason);
+        
+        for(int32_t i = 0; i < jason->ExpansionsSize; i++)
+        {
+            if(jason->Expansions[i] != NULL)
+            {
+                jason_Cleanup(&jason->Expansions[i]->Document);
+                jason->Free(jason->Expansions[i]);
+                jason->Expansions[i] = NULL;
+            }
+        }
+        
+        jason->NumExpansions = 0;
+        
+        if(jason->SourceBlocks != NULL)
+        {
+            while(jason->SourceBlocks->Prev != NULL)
+            {
+                jasonSourceBlock *prev = jason->SourceBlocks->Prev->Prev;
+                jason->Free(jason->SourceBlocks->Prev);
+                jason->SourceBlocks->Prev = prev;
+            }
+            
+            jason->SourceBlocks->Used = 0;
+        }
+    }
+    
+    void *jason_Malloc(size_t *size)
+    {
+        void *ret = malloc(*size);
+        if(ret == NULL)
+        {
+            *size = 0;
+        }
+        
+        return ret;
+    }
+    
+    void jason_Free(void * ptr)
+    {
+        free(ptr);
+    }
+    
+    void *jason_Realloc(void *ptr, size_t *size)
+    {
+        void *newPtr = realloc(ptr, *size);
+        if(newPtr == NULL)
+        {
+            *size = 0;
+        }
+        
+        return newPtr;
+    }
+    
+    // size bytes from the arena, 8-byte aligned. A request larger than a block gets a block of its own
+    void *jasonArena_Alloc(jasonArena *arena, size_t size)
+    {
+        if(arena->Malloc == NULL || arena->Free == NULL)
+        {
+            arena->Malloc = jason_Malloc;
+            arena->Free = jason_Free;
+        }
+        
+        size = (size + 7) & ~(size_t)7;
+        jasonSourceBlock *block = arena->Blocks;
+        
+        if(block == NULL || block->Size - block->Used < size)
+        {
+            size_t blockSize = arena->BlockSize > 0 ? arena->BlockSize : JASON_ARENA_BLOCK_SIZE;
+            if(size > SIZE_MAX - sizeof(jasonSourceBlock))
+            {
+                return NULL;
+            }
+            
+            size_t memLength = sizeof(jasonSourceBlock) + (size > blockSize ? size : blockSize);
+            jasonSourceBlock *newBlock = arena->Malloc(&memLength);
+            if(newBlock == NULL || memLength < sizeof(jasonSourceBlock) + size)
+            {
+                arena->Free(newBlock);
+                return NULL;
+            }
+            
+            newBlock->Size = memLength - sizeof(jasonSourceBlock);
+            newBlock->Used = 0;
+            
+            if(block != NULL && size > blockSize)
+            {
+                // keep filling the current block, the big one goes behind it
+                newBlock->Prev = block->Prev;
+                block->Prev = newBlock;
+                newBlock->Used = size;
+                return JASON_SOURCEBLOCK_DATA(newBlock);
+            }
+            
+            newBlock->Prev = block;
+            arena->Blocks = newBlock;
+            block = newBlock;
+        }
+        
+        void *ptr = JASON_SOURCEBLOCK_DATA(block) + block->Used;
+        block->Used += size;
+        return ptr;
+    }
+    
+    void jasonArena_Free(jasonArena *arena)
+    {
+        while(arena->Blocks != NULL)
+        {
+            jasonSourceBlock *prev = arena->Blocks->Prev;
+            arena->Free(arena->Blocks);
+            arena->Blocks = prev;
+        }
+    }
+    
+    // make the whole arena free again, keeping blocks up to maxRetainedBytes for what comes next
+    void jasonArena_Reset(jasonArena *arena, size_t maxRetainedBytes)
+    {
+        size_t retained = 0;
+        for(jasonSourceBlock **it = &arena->Blocks; *it != NULL;)
+        {
+            jasonSourceBlock *block = *it;
+            if(retained + block->Size <= maxRetainedBytes)
+            {
+                retained += block->Size;
+                block->Used = 0;
+                it = &block->Prev;
+                continue;
+            }
+            
+            *it = block->Prev;
+            arena->Free(block);
+        }
+    }
+    
+    uint32_t jason_ParseHex4(const char *hex)
+    {
+        uint32_t value = 0;
+        for(int i = 0; i < 4; i++)
+        {
+            char c = hex[i];
+            uint32_t digit;
+            
+            if(c >= '0' && c <= '9')
+            {
+                digit = (uint32_t)(c - '0');
+            }
+            else if(c >= 'a' && c <= 'f')
+            {
+                digit = (uint32_t)(c - 'a' + 10);
+            }
+            else if(c >= 'A' && c <= 'F')
+            {
+                digit = (uint32_t)(c - 'A' + 10);
+            }
+            else
+            {
+                return UINT32_MAX;
+            }
+            
+            value = (value << 4) | digit;
+        }
+        
+        return value;
+    }
+    
+    char *jason_EncodeUtf8(char *out, uint32_t codepoint)
+    {
+        if(codepoint < 0x80)
+        {
+            *out++ = (char)codepoint;
+        }
+        else if(codepoint < 0x800)
+        {
+            *out++ = (char)(0xC0 | (codepoint >> 6));
+            *out++ = (char)(0x80 | (codepoint & 0x3F));
+        }
+        else if(codepoint < 0x10000)
+        {
+            *out++ = (char)(0xE0 | (codepoint >> 12));
+            *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (codepoint & 0x3F));
+        }
+        else
+        {
+            *out++ = (char)(0xF0 | (codepoint >> 18));
+            *out++ = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+            *out++ = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (codepoint & 0x3F));
+        }
+        
+        return out;
+    }
+    
+    // decode a string value into buffer as null-terminated UTF-8. Decoding never grows a string,
+    // so a buffer of jasonValue_GetValueLen(value) + 1 bytes is always enough
+    jasonStatus jasonValue_UnescapeInto(jasonValue *value, char *buffer, jasonSize bufferLen, jasonSize *length)
+    {
+        if(jasonValue_GetType(value) != jasonValueType_String)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        const char *src = jasonValue_GetValue(value);
+        jasonSize srcLen = jasonValue_GetValueLen(value);
+        const char *end = src + srcLen;
+        char *out = buffer;
+        
+        if(bufferLen <= srcLen)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        if(!jasonValue_HasEscapes(value))
+        {
+            memcpy(buffer, src, srcLen);
+            buffer[srcLen] = '\0';
+            *length = srcLen;
+            return jasonStatus_Finished;
+        }
+        
+        while(src < end)
+        {
+#if defined(JASON_X86_SIMD) && defined(__SSE2__)
+            // move 16 bytes at a time up to the next backslash. The output never runs ahead of the input,
+            // so a full store always fits in the buffer
+            while(end - src >= 16)
+            {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)src);
+                _mm_storeu_si128((__m128i*)out, chunk);
+                
+                uint32_t backslashes = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+                if(backslashes != 0)
+                {
+                    int skip = jason_CountTrailingZeros(backslashes);
+                    src += skip;
+                    out += skip;
+                    break;
+                }
+                
+                src += 16;
+                out += 16;
+            }
+#endif
+            while(src < end && *src != '\\')
+            {
+                *out++ = *src++;
+            }
+            
+            if(src >= end)
+            {
+                break;
+            }
+            
+            if(src + 1 >= end)
+            {
+                return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+            }
+            
+            char escape = src[1];
+            src += 2;
+            
+            switch(escape)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                    *out++ = escape;
+                    break;
+                    
+                case 'b':
+                    *out++ = '\b';
+                    break;
+                    
+                case 'f':
+                    *out++ = '\f';
+                    break;
+                    
+                case 'n':
+                    *out++ = '\n';
+                    break;
+                    
+                case 'r':
+                    *out++ = '\r';
+                    break;
+                    
+                case 't':
+                    *out++ = '\t';
+                    break;
+                    
+                case 'u':
+                {
+                    uint32_t codepoint = (end - src >= 4) ? jason_ParseHex4(src) : UINT32_MAX;
+                    if(codepoint == UINT32_MAX)
+                    {
+                        return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    }
+                    
+                    src += 4;
+                    
+                    if(codepoint >= 0xD800 && codepoint <= 0xDBFF)
+                    {
+                        // a high surrogate has to be followed by an escaped low one
+                        uint32_t low = (end - src >= 6 && src[0] == '\\' && src[1] == 'u') ? jason_ParseHex4(src + 2) : UINT32_MAX;
+                        if(low < 0xDC00 || low > 0xDFFF)
+                        {
+                            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                        }
+                        
+                        src += 6;
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    else if(codepoint >= 0xDC00 && codepoint <= 0xDFFF)
+                    {
+                        return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    }
+                    
+                    out = jason_EncodeUtf8(out, codepoint);
+                    break;
+                }
+                    
+                default:
+                    return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+            }
+        }
+        
+        *out = '\0';
+        *length = (jasonSize)(out - buffer);
+        return jasonStatus_Finished;
+    }
+    
+    // decode a string value into memory from jason's Malloc callback, to be released with its Free callback
+    jasonStatus jason_CopyString(jason *jason, jasonValue *value, char **string, jasonSize *length)
+    {
+        if(jasonValue_GetType(value) != jasonValueType_String)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        jasonMallocCb_t mallocCb = (jason->Malloc != NULL) ? jason->Malloc : jason_Malloc;
+        jasonFreeCb_t freeCb = (jason->Free != NULL) ? jason->Free : jason_Free;
+        size_t needed = (size_t)jasonValue_GetValueLen(value) + 1;
+        size_t memLength = needed;
+        char *buffer = mallocCb(&memLength);
+        
+        if(buffer == NULL || memLength < needed)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        jasonStatus status = jasonValue_UnescapeInto(value, buffer, (jasonSize)needed, length);
+        if(status != jasonStatus_Finished)
+        {
+            freeCb(buffer);
+            return status;
+        }
+        
+        *string = buffer;
+        return jasonStatus_Finished;
+    }
+    
+    // repack a parsed document as a jasonCompactTape. Offsets are taken from the first value, so the
+    // document must sit in one buffer smaller than 4GB and no single value may reach JASON_COMPACT_LEN_MASK
+    jasonStatus jason_Compact(jason *jason, jasonCompactTape *tape)
+    {
+        memset(tape, 0, sizeof(jasonCompactTape));
+        
+        if(jason->NumValues == 0)
+        {
+            return jasonStatus_Finished;
+        }
+        
+        if(jason->SourceBlocks != NULL && jason->SourceBlocks->Prev != NULL)
+        {
+            // fed in pieces that ended up in different blocks
+            return jasonStatus_Break(jasonStatus_IntegerOverflow);
+        }
+        
+        if(jason->NumValues > INT32_MAX)
+        {
+            return jasonStatus_Break(jasonStatus_IntegerOverflow);
+        }
+        
+        size_t memLength = (size_t)jason->NumValues * sizeof(jasonCompactValue);
+        jasonCompactValue *nodes = jason->Malloc(&memLength);
+        if(nodes == NULL || memLength < (size_t)jason->NumValues * sizeof(jasonCompactValue))
+        {
+            jason->Free(nodes);
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        const char *source = jason->RootValue->Value;
+        
+        for(jasonSize i = 0; i < jason->NumValues; i++)
+        {
+            jasonValue *value = jason->RootValue + i;
+            jasonValueType type = jasonValue_GetType(value);
+            const char *text = jasonValue_GetValue(value);
+            jasonSize length = (type == jasonValueType_Object || type == jasonValueType_Array) ? value->ValueLen : jasonValue_GetValueLen(value);
+            
+            // a container skipped by jasonFlag_Lazy has no children here to point at
+            if(text < source || length < 0 || (size_t)(text - source) > UINT32_MAX || length > (jasonSize)JASON_COMPACT_LEN_MASK)
+            {
+                jason->Free(nodes);
+                return jasonStatus_Break(jasonStatus_IntegerOverflow);
+            }
+            
+            nodes[i].Offset = (uint32_t)(text - source);
+            nodes[i].Info = ((uint32_t)type << JASON_COMPACT_TYPE_SHIFT) | (uint32_t)length | (jasonValue_HasEscapes(value) ? JASON_COMPACT_ESCAPED : 0);
+            nodes[i].Next = (int32_t)value->Next;
+        }
+        
+        tape->Source = source;
+        tape->Nodes = nodes;
+        tape->NumNodes = (int32_t)jason->NumValues;
+        return jasonStatus_Finished;
+    }
+    
+    void jason_FreeCompact(jason *jason, jasonCompactTape *tape)
+    {
+        jason->Free(tape->Nodes);
+        memset(tape, 0, sizeof(jasonCompactTape));
+    }
+    
+    // a key hashed once up front, usable against any document hashed with the same function. The key text is not copied
+    void jasonKey_Compile(jasonKey *handle, const char *key, int32_t keyLen, jasonHashCb_t hash)
+    {
+        handle->Key = key;
+        handle->KeyLen = keyLen;
+        handle->HashFn = (hash != NULL) ? hash : jason_Hash;
+        handle->Seed = jason_HashSeed();
+        handle->Hash = handle->HashFn((char*)key, keyLen);
+    }
+    
+    // the handle's hash when it was compiled the way the document hashes its keys
+    uint32_t jason_HandleHash(jason *jason, const jasonKey *handle)
+    {
+        if(handle->HashFn == jason->Hash && (handle->HashFn != jason_Hash || handle->Seed == jason->HashSeed))
+        {
+            return handle->Hash;
+        }
+        
+        return jason_HashKey(jason, handle->Key, handle->KeyLen);
+    }
+    
+    jasonValue *jason_LookupKey(jason *jason, jasonValue *parent, const jasonKey *handle)
+    {
+        parent = jason_ResolveLazy(&jason, parent);
+        if(parent == NULL || jasonValue_GetType(parent) != jasonValueType_Object || parent->ValueLen == 0)
+        {
+            return NULL;
+        }
+        
+        jasonObjectIndex *index = jason_FindObjectIndex(jason, (jasonSize)(parent - jason->RootValue));
+        if(index == NULL)
+        {
+            JASON_STATS_ADD(jason, ScannedLookups, 1);
+            return jason_ScanObjectKeys(parent, handle->Key, handle->KeyLen);
+        }
+        
+        uint32_t hash = jason_HandleHash(jason, handle);
+        return jason_ProbeObjectIndex(jason, parent, index, handle->Key, handle->KeyLen, hash);
+    }
+    
+    // resolve several keys against one object, small objects are walked once for all of them. Returns how many were found
+    int32_t jason_LookupKeys(jason *jason, jasonValue *parent, const jasonKey *handles, int32_t numHandles, jasonValue **values)
+    {
+        for(int32_t i = 0; i < numHandles; i++)
+        {
+            values[i] = NULL;
+        }
+        
+        parent = jason_ResolveLazy(&jason, parent);
+        if(parent == NULL || jasonValue_GetType(parent) != jasonValueType_Object || parent->ValueLen == 0)
+        {
+            return 0;
+        }
+        
+        int32_t numFound = 0;
+        jasonObjectIndex *index = jason_FindObjectIndex(jason, (jasonSize)(parent - jason->RootValue));
+        
+        if(index != NULL)
+        {
+            for(int32_t i = 0; i < numHandles; i++)
+            {
+                const jasonKey *handle = handles + i;
+                uint32_t hash = jason_HandleHash(jason, handle);
+                values[i] = jason_ProbeObjectIndex(jason, parent, index, handle->Key, handle->KeyLen, hash);
+                numFound += (values[i] != NULL);
+            }
+            
+            return numFound;
+        }
+        
+        JASON_STATS_ADD(jason, ScannedLookups, numHandles);
+        for(jasonValue *key = parent + 1; numFound < numHandles; key += key->Next)
+        {
+            const char *keyStr = jasonValue_GetValue(key);
+            jasonSize keyLen = jasonValue_GetValueLen(key);
+            
+            for(int32_t i = 0; i < numHandles; i++)
+            {
+                if(values[i] == NULL && handles[i].KeyLen == keyLen && memcmp(handles[i].Key, keyStr, keyLen) == 0)
+                {
+                    values[i] = key + 1;
+                    numFound++;
+                }
+            }
+            
+            if(key->Next == 0)
+            {
+                break;
+            }
+        }
+        
+        return numFound;
+    }
+    
+    void jasonPath_Free(jasonPath *path)
+    {
+        jason_Free(path->Segments);
+        path->Segments = NULL;
+        path->NumSegments = 0;
+    }
+    
+    // compile a JSON Pointer such as "/Users/3/Name", undoing the ~0 and ~1 escapes
+    jasonStatus jasonPath_Compile(jasonPath *path, const char *pointer, int32_t pointerLen, jasonHashCb_t hash)
+    {
+        memset(path, 0, sizeof(jasonPath));
+        
+        if(pointerLen > 0 && pointer[0] != '/')
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        if(pointerLen <= 0)
+        {
+            // the whole document
+            return jasonStatus_Continue;
+        }
+        
+        for(int32_t i = 0; i < pointerLen; i++)
+        {
+            path->NumSegments += (pointer[i] == '/');
+        }
+        
+        // segments, followed by their unescaped text
+        size_t memLength = path->NumSegments * sizeof(jasonPathSegment) + pointerLen;
+        path->Segments = jason_Malloc(&memLength);
+        if(path->Segments == NULL)
+        {
+            path->NumSegments = 0;
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        char *text = (char*)(path->Segments + path->NumSegments);
+        const char *end = pointer + pointerLen;
+        const char *it = pointer;
+        
+        for(int32_t s = 0; s < path->NumSegments; s++)
+        {
+            jasonPathSegment *segment = path->Segments + s;
+            char *keyStart = text;
+            int64_t arrayIndex = 0;
+            
+            for(it++; it < end && *it != '/'; it++)
+            {
+                if(*it == '~')
+                {
+                    if(it + 1 >= end || (it[1] != '0' && it[1] != '1'))
+                    {
+                        jasonPath_Free(path);
+                        return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    }
+                    
+                    *text++ = (it[1] == '0') ? '~' : '/';
+                    it++;
+                }
+                else
+                {
+                    *text++ = *it;
+                }
+            }
+            
+            int32_t keyLen = (int32_t)(text - keyStart);
+            for(int32_t i = 0; i < keyLen && arrayIndex >= 0; i++)
+            {
+                arrayIndex = JASON_ISDIGIT(keyStart[i]) ? arrayIndex * 10 + (keyStart[i] - '0') : -1;
+                arrayIndex = arrayIndex > INT_MAX ? -1 : arrayIndex;
+            }
+            
+            segment->Index = (keyLen > 0 && (keyLen == 1 || keyStart[0] != '0')) ? (int32_t)arrayIndex : -1;
+            jasonKey_Compile(&segment->Key, keyStart, keyLen, hash);
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    jasonValue *jason_LookupPath(jason *jason, jasonValue *root, const jasonPath *path)
+    {
+        jasonValue *value = (root != NULL) ? root : jason->RootValue;
+        
+        for(int32_t s = 0; s < path->NumSegments && value != NULL; s++)
+        {
+            const jasonPathSegment *segment = path->Segments + s;
+            
+            if(jasonValue_GetType(value) == jasonValueType_Array)
+            {
+                if(segment->Index < 0)
+                {
+                    return NULL;
+                }
+                
+                value = jason_GetFirstChild(jason, value);
+                for(int32_t i = 0; i < segment->Index && value != NULL; i++)
+                {
+                    value = jasonValue_GetNextSibling(value);
+                }
+            }
+            else
+            {
+                value = jason_LookupKey(jason, value, &segment->Key);
+            }
+        }
+        
+        return value;
+    }
+    
+    // read a number into a jasonDecimal, 0 when the text is not a number by the grammar of RFC 8259 or its exponent is
+    // too large to count. Leading zeros are let through, as the loose parse lets them through
+    int32_t jason_ReadDecimal(const char *text, jasonSize len, jasonDecimal *decimal)
+    {
+        const char *it = text;
+        const char *end = text + len;
+        const char *point = NULL;
+        const char *first = NULL;
+        const char *last = NULL;
+        const char *integerEnd = NULL;
+        
+        decimal->Negative = (it < end && *it == '-');
+        it += decimal->Negative;
+        const char *mantissa = it;
+        
+        for(; it < end && (JASON_ISDIGIT(*it) || (*it == '.' && point == NULL && it > mantissa)); it++)
+        {
+            if(*it == '.')
+            {
+                point = it;
+            }
+            else if(*it != '0')
+            {
+                first = (first != NULL) ? first : it;
+                last = it;
+            }
+        }
+        
+        integerEnd = (point != NULL) ? point : it;
+        if(it == mantissa || it[-1] == '.')
+        {
+            return 0;
+        }
+        
+        int64_t exponent = 0;
+        if(it < end && (*it == 'e' || *it == 'E'))
+        {
+            it++;
+            int32_t negativeExponent = (it < end && *it == '-');
+            it += (it < end && (*it == '-' || *it == '+'));
+            if(it >= end)
+            {
+                return 0;
+            }
+            
+            for(; it < end && JASON_ISDIGIT(*it); it++)
+            {
+                if(exponent > 1000000000000000ll)
+                {
+                    return 0;
+                }
+                
+                exponent = exponent * 10 + (*it - '0');
+            }
+            
+            exponent = negativeExponent ? -exponent : exponent;
+        }
+        
+        if(it != end)
+        {
+            return 0;
+        }
+        
+        if(first == NULL)
+        {
+            // -0 and 0 are one value
+            memset(decimal, 0, sizeof(jasonDecimal));
+            return 1;
+        }
+        
+        int32_t spansPoint = (point != NULL && first < point && last > point);
+        decimal->Digits = first;
+        decimal->DigitsEnd = last + 1;
+        decimal->NumDigits = (jasonSize)(last - first + 1 - spansPoint);
+        decimal->Exponent = exponent + ((last < integerEnd) ? (int64_t)(integerEnd - last - 1) : -(int64_t)(last - point));
+        return 1;
+    }
+    
+    // the key of a decimal that a 64-bit integer or a double holds exactly, as jason_CanonicalNumber keys numbers.
+    // jasonIndexKeyKind_None for any other value: 0.1, which no double holds, or integers past 64 bits
+    jasonIndexKeyKind jason_DecimalKey(const jasonDecimal *decimal, uint64_t *bits)
+    {
+        if(decimal->NumDigits > 20 || decimal->Exponent > 20 || decimal->Exponent < -27)
+        {
+            return jasonIndexKeyKind_None;
+        }
+        
+        uint64_t value = 0;
+        for(const char *it = decimal->Digits; it < decimal->DigitsEnd; it++)
+        {
+            if(*it == '.')
+            {
+                continue;
+            }
+            
+            uint64_t digit = (uint64_t)(*it - '0');
+            if(value > (UINT64_MAX - digit) / 10)
+            {
+                return jasonIndexKeyKind_None;
+            }
+            
+            value = value * 10 + digit;
+        }
+        
+        if(decimal->Exponent < 0)
+        {
+            // the digits have no trailing zero, so value * 10^-k is odd * 2^-k when 5^k divides value, and a double
+            // holds that when the odd part has at most 53 bits
+            uint64_t power = 1;
+            for(int64_t i = 0; i < -decimal->Exponent; i++)
+            {
+                power *= 5;
+            }
+            
+            if(value % power != 0 || value / power >= ((uint64_t)1 << 53))
+            {
+                return jasonIndexKeyKind_None;
+            }
+            
+            double exact = (double)(value / power) / (double)((uint64_t)1 << -decimal->Exponent);
+            exact = decimal->Negative ? -exact : exact;
+            memcpy(bits, &exact, sizeof(double));
+            return jasonIndexKeyKind_Double;
+        }
+        
+        for(int64_t i = 0; i < decimal->Exponent; i++)
+        {
+            if(value > UINT64_MAX / 10)
+            {
+                return jasonIndexKeyKind_None;
+            }
+            
+            value *= 10;
+        }
+        
+        if(decimal->Negative)
+        {
+            if(value > (uint64_t)INT64_MAX + 1)
+            {
+                return jasonIndexKeyKind_None;
+            }
+            
+            *bits = 0 - value;
+            return jasonIndexKeyKind_Int64;
+        }
+        
+        *bits = value;
+        return (value <= INT64_MAX) ? jasonIndexKeyKind_Int64 : jasonIndexKeyKind_Uint64;
+    }
+    
+    // whether two decimals are one value
+    int32_t jason_SameDecimal(const jasonDecimal *a, const jasonDecimal *b)
+    {
+        if(a->NumDigits != b->NumDigits || a->Exponent != b->Exponent || a->Negative != b->Negative)
+        {
+            return 0;
+        }
+        
+        const char *itB = b->Digits;
+        for(const char *itA = a->Digits; itA < a->DigitsEnd; itA++, itB++)
+        {
+            itA += (*itA == '.');
+            itB += (*itB == '.');
+            if(*itA != *itB)
+            {
+                return 0;
+            }
+        }
+        
+        return 1;
+    }
+    
+    // the digits without the decimal point, a block at a time, then the sign and exponent
+    uint64_t jason_DecimalDigest(const jasonDecimal *decimal, uint64_t seed)
+    {
+        uint64_t digest = seed;
+        char block[32];
+        size_t used = 0;
+        for(const char *it = decimal->Digits; it < decimal->DigitsEnd; it++)
+        {
+            block[used] = *it;
+            used += (*it != '.');
+            if(used == sizeof(block))
+            {
+                digest = jason_Hash64(block, used, digest);
+                used = 0;
+            }
+        }
+        
+        uint64_t bits = ((uint64_t)decimal->Exponent << 1) | (uint64_t)decimal->Negative;
+        digest = jason_Hash64(block, used, digest);
+        return jason_Hash64((const char*)&bits, sizeof(bits), digest);
+    }
+    
+    // whether two number texts are one value, the same text when either has an exponent too large to read
+    int32_t jason_SameNumberText(const char *textA, jasonSize lenA, const char *textB, jasonSize lenB)
+    {
+        if(lenA == lenB && memcmp(textA, textB, (size_t)lenA) == 0)
+        {
+            return 1;
+        }
+        
+        jasonDecimal decimalA, decimalB;
+        return jason_ReadDecimal(textA, lenA, &decimalA) && jason_ReadDecimal(textB, lenB, &decimalB) && jason_SameDecimal(&decimalA, &decimalB);
+    }
+    
+    // integers key by their value whatever they were written as, so 1, 1.0 and 1e0 match and no bits are lost past 2^53.
+    // Other numbers key by their double, which is their value only when it did not come from text: jason_IndexKeyOf
+    // reads numbers from their digits with jason_NumberKey
+    jasonIndexKeyKind jason_CanonicalNumber(const jasonNumber *number, uint64_t *bits)
+    {
+        double value = 0;
+        
+        switch(number->Type)
+        {
+            case jasonNumberType_Int64:
+                *bits = (uint64_t)number->Int64;
+                return jasonIndexKeyKind_Int64;
+                
+            case jasonNumberType_Uint64:
+                *bits = number->Uint64;
+                return (number->Uint64 <= INT64_MAX) ? jasonIndexKeyKind_Int64 : jasonIndexKeyKind_Uint64;
+                
+            default:
+                value = number->Double;
+                break;
+        }
+        
+        // the bounds are 2^63 and 2^64, which a double holds exactly
+        if(value >= -9223372036854775808.0 && value < 9223372036854775808.0 && value == (double)(int64_t)value)
+        {
+            *bits = (uint64_t)(int64_t)value;
+            return jasonIndexKeyKind_Int64;
+        }
+        
+        if(value >= 9223372036854775808.0 && value < 18446744073709551616.0 && value == (double)(uint64_t)value)
+        {
+            *bits = (uint64_t)value;
+            return jasonIndexKeyKind_Uint64;
+        }
+        
+        memcpy(bits, &value, sizeof(double));
+        return jasonIndexKeyKind_Double;
+    }
+    
+    void jason_HashNumberKey(jason *jason, jasonIndexKey *key)
+    {
+        uint64_t seed = (jason->HashSeed != 0) ? jason->HashSeed : jason_HashSeed();
+        key->Hash = jason_HashSeeded((const char*)&key->Bits, sizeof(uint64_t), seed + key->Kind);
+    }
+    
+    // the key of the number written in key.Text, whose nearest value is 'nearest'. A number a 64-bit integer or a
+    // double holds exactly keys as jason_CanonicalNumber keys it, any other by its digits, so 0.1 and 1e-1 match
+    // while 9007199254740993 and 9007199254740992 or 1e400 and 2e400, which round to one double, do not
+    void jason_NumberKey(jason *jason, jasonIndexKey *key, double nearest)
+    {
+        jasonDecimal decimal;
+        int32_t isRead = jason_ReadDecimal(key->Text, key->TextLen, &decimal);
+        key->Kind = isRead ? jason_DecimalKey(&decimal, &key->Bits) : jasonIndexKeyKind_None;
+        if(key->Kind != jasonIndexKeyKind_None)
+        {
+            jason_HashNumberKey(jason, key);
+            return;
+        }
+        
+        // an exponent too large to read leaves only the text to go by
+        uint64_t seed = (jason->HashSeed != 0) ? jason->HashSeed : jason_HashSeed();
+        key->Kind = jasonIndexKeyKind_Decimal;
+        key->Hash = isRead ? (uint32_t)jason_DecimalDigest(&decimal, seed + key->Kind) : jason_HashKey(jason, key->Text, (int32_t)key->TextLen);
+        memcpy(&key->Bits, &nearest, sizeof(double));
+    }
+    
+    // the key of a string or number value, jasonIndexKeyKind_None for anything else. The value can come from another
+    // document, the hash is the one of 'jason'
+    jasonIndexKeyKind jason_IndexKeyOf(jason *jason, jasonValue *value, jasonIndexKey *key)
+    {
+        jasonNumber number;
+        memset(key, 0, sizeof(jasonIndexKey));
+        
+        switch(jasonValue_GetType(value))
+        {
+            case jasonValueType_String:
+                key->Kind = jasonIndexKeyKind_String;
+                key->Text = jasonValue_GetValue(value);
+                key->TextLen = jasonValue_GetValueLen(value);
+                key->Hash = jason_HashKey(jason, key->Text, (int32_t)key->TextLen);
+                break;
+                
+            case jasonValueType_Number:
+                if(jason_GetNumber(jason, value, &number) != jasonStatus_Finished)
+                {
+                    break;
+                }
+                
+                // a 64-bit integer is exact already, anything else is read again from its digits
+                if(number.Type == jasonNumberType_Int64 || number.Type == jasonNumberType_Uint64)
+                {
+                    key->Kind = jason_CanonicalNumber(&number, &key->Bits);
+                    jason_HashNumberKey(jason, key);
+                }
+                else
+                {
+                    key->Text = jasonValue_GetValue(value);
+                    key->TextLen = jasonValue_GetValueLen(value);
+                    jason_NumberKey(jason, key, number.Double);
+                }
+                
+                break;
+                
+            default:
+                break;
+        }
+        
+        return key->Kind;
+    }
+    
+    double jason_IndexKeyNumber(const jasonIndexKey *key)
+    {
+        double value;
+        switch(key->Kind)
+        {
+            case jasonIndexKeyKind_Int64:
+                return (double)(int64_t)key->Bits;
+                
+            case jasonIndexKeyKind_Uint64:
+                return (double)key->Bits;
+                
+            default:
+                memcpy(&value, &key->Bits, sizeof(double));
+                return value;
+        }
+    }
+    
+    // the slot holding the key, or the unused one it would go in
+    jasonIndexSlot *jason_FindIndexSlot(const jasonValueIndex *index, const jasonIndexKey *key)
+    {
+        jasonSize mask = index->Capacity - 1;
+        for(jasonSize i = key->Hash & mask; ; i = (i + 1) & mask)
+        {
+            jasonIndexSlot *slot = index->Slots + i;
+            if(slot->Count == 0)
+            {
+                return slot;
+            }
+            
+            if(slot->Key.Hash == key->Hash && slot->Key.Kind == key->Kind)
+            {
+                int32_t isSame = (key->Kind == jasonIndexKeyKind_Decimal) ? jason_SameNumberText(slot->Key.Text, slot->Key.TextLen, key->Text, key->TextLen) : slot->Key.Bits == key->Bits;
+                if(key->Kind == jasonIndexKeyKind_String ? (slot->Key.TextLen == key->TextLen && memcmp(slot->Key.Text, key->Text, key->TextLen) == 0) : isSame)
+                {
+                    return slot;
+                }
+            }
+        }
+    }
+    
+    // order the numbers of a sorted index, elements with equal numbers staying in array order. Heapsort, as for the keys of
+    // an object
+    void jason_SortIndexNumbers(jasonValueIndex *index)
+    {
+        double *numbers = index->SortedNumbers;
+        jasonValue **elements = index->Sorted;
+        
+        for(jasonSize end = index->NumSorted, start = index->NumSorted / 2; end > 1;)
+        {
+            jasonSize root = 0;
+            if(start > 0)
+            {
+                root = --start;
+            }
+            else
+            {
+                end--;
+                double topNumber = numbers[0];
+                jasonValue *topElement = elements[0];
+                numbers[0] = numbers[end];
+                elements[0] = elements[end];
+                numbers[end] = topNumber;
+                elements[end] = topElement;
+            }
+            
+            for(jasonSize child = root * 2 + 1; child < end; child = root * 2 + 1)
+            {
+                // the tape keeps siblings in array order, so their addresses break ties
+                if(child + 1 < end && (numbers[child] < numbers[child + 1] || (numbers[child] == numbers[child + 1] && elements[child] < elements[child + 1])))
+                {
+                    child++;
+                }
+                
+                if(numbers[root] > numbers[child] || (numbers[root] == numbers[child] && elements[root] > elements[child]))
+                {
+                    break;
+                }
+                
+                double swapNumber = numbers[root];
+                jasonValue *swapElement = elements[root];
+                numbers[root] = numbers[child];
+                elements[root] = elements[child];
+                numbers[child] = swapNumber;
+                elements[child] = swapElement;
+                root = child;
+            }
+        }
+    }
+    
+    // index the elements of an array by the value at keyPath, a JSON Pointer taken from each element such as "/Name" or
+    // "/address/zip", or "" for the elements themselves. Strings and numbers are indexed, elements without one at the
+    // path are left out. The index is kept by the document until jason_Reset or jason_Cleanup
+    jasonStatus jason_BuildIndex(jason *jason, jasonValue *array, const char *keyPath, int32_t keyPathLen, uint32_t flags, jasonValueIndex **index)
+    {
+        *index = NULL;
+        
+        // the index goes with the document holding the elements, an expansion when the array was skipped by jasonFlag_Lazy
+        array = (array != NULL) ? jason_ResolveLazy(&jason, array) : NULL;
+        if(array == NULL || jasonValue_GetType(array) != jasonValueType_Array)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        jasonPath path;
+        jasonStatus status = jasonPath_Compile(&path, keyPath, keyPathLen, jason->Hash);
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        jasonSize numElements = 0;
+        for(jasonValue *element = jasonValue_GetFirstChild(array); element != NULL; element = jasonValue_GetNextSibling(element))
+        {
+            numElements++;
+        }
+        
+        jasonSize capacity = 16;
+        while(capacity < numElements * 2)
+        {
+            capacity *= 2;
+        }
+        
+        // the index, its slots, then the sorted numbers ahead of the element pointers to keep them aligned
+        size_t header = (sizeof(jasonValueIndex) + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+        size_t numSortable = (flags & jasonIndexFlag_Sorted) ? (size_t)numElements : 0;
+        size_t bytes = header + capacity * sizeof(jasonIndexSlot) + numSortable * sizeof(double) + (numElements + numSortable) * sizeof(jasonValue*);
+        size_t memLength = bytes;
+        jasonValueIndex *newIndex = jason->Malloc(&memLength);
+        
+        // the slot of each element, or -1, between the two passes
+        size_t slotsLength = (numElements > 0 ? numElements : 1) * sizeof(jasonSize);
+        jasonSize *slotOf = jason->Malloc(&slotsLength);
+        
+        if(newIndex == NULL || memLength < bytes || slotOf == NULL || slotsLength < numElements * sizeof(jasonSize))
+        {
+            jason->Free(newIndex);
+            jason->Free(slotOf);
+            jasonPath_Free(&path);
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        memset(newIndex, 0, header + capacity * sizeof(jasonIndexSlot));
+        newIndex->Document = jason;
+        newIndex->Array = array;
+        newIndex->Capacity = capacity;
+        newIndex->Slots = (jasonIndexSlot*)((char*)newIndex + header);
+        newIndex->SortedNumbers = (double*)(newIndex->Slots + capacity);
+        newIndex->Elements = (jasonValue**)(newIndex->SortedNumbers + numSortable);
+        newIndex->Sorted = (numSortable > 0) ? newIndex->Elements + numElements : NULL;
+        newIndex->SortedNumbers = (numSortable > 0) ? newIndex->SortedNumbers : NULL;
+        
+        jasonSize i = 0;
+        for(jasonValue *element = jasonValue_GetFirstChild(array); element != NULL; element = jasonValue_GetNextSibling(element), i++)
+        {
+            jasonIndexKey key;
+            jasonValue *value = jason_LookupPath(jason, element, &path);
+            if(value == NULL || jason_IndexKeyOf(jason, value, &key) == jasonIndexKeyKind_None)
+            {
+                slotOf[i] = -1;
+                continue;
+            }
+            
+            jasonIndexSlot *slot = jason_FindIndexSlot(newIndex, &key);
+            if(slot->Count == 0)
+            {
+                slot->Key = key;
+                newIndex->NumKeys++;
+            }
+            
+            slot->Count++;
+            slotOf[i] = (jasonSize)(slot - newIndex->Slots);
+            
+            if(numSortable > 0 && key.Kind != jasonIndexKeyKind_String)
+            {
+                newIndex->SortedNumbers[newIndex->NumSorted] = jason_IndexKeyNumber(&key);
+                newIndex->Sorted[newIndex->NumSorted++] = element;
+            }
+        }
+        
+        // each key's elements follow those of the keys in the slots before it, Count counts them in again below
+        for(jasonSize s = 0; s < capacity; s++)
+        {
+            jasonIndexSlot *slot = newIndex->Slots + s;
+            slot->First = newIndex->NumElements;
+            newIndex->NumElements += slot->Count;
+            slot->Count = 0;
+        }
+        
+        i = 0;
+        for(jasonValue *element = jasonValue_GetFirstChild(array); element != NULL; element = jasonValue_GetNextSibling(element), i++)
+        {
+            if(slotOf[i] >= 0)
+            {
+                jasonIndexSlot *slot = newIndex->Slots + slotOf[i];
+                newIndex->Elements[slot->First + slot->Count++] = element;
+            }
+        }
+        
+        jason_SortIndexNumbers(newIndex);
+        jason->Free(slotOf);
+        jasonPath_Free(&path);
+        
+        newIndex->Next = jason->Indexes;
+        jason->Indexes = newIndex;
+        *index = newIndex;
+        return jasonStatus_Finished;
+    }
+    
+    jasonSize jason_IndexFindKey(const jasonValueIndex *index, const jasonIndexKey *key, jasonValue ***elements)
+    {
+        jasonIndexSlot *slot = jason_FindIndexSlot(index, key);
+        *elements = (slot->Count > 0) ? index->Elements + slot->First : NULL;
+        return slot->Count;
+    }
+    
+    // the elements whose value at the index's path is the string str, compared with its escapes as written like keys are.
+    // Returns how many there are, *elements is set to the first of them and the others follow in array order
+    jasonSize jason_IndexFind(const jasonValueIndex *index, const char *str, jasonSize strLen, jasonValue ***elements)
+    {
+        jasonIndexKey key;
+        memset(&key, 0, sizeof(jasonIndexKey));
+        key.Kind = jasonIndexKeyKind_String;
+        key.Text = str;
+        key.TextLen = strLen;
+        key.Hash = jason_HashKey(index->Document, str, (int32_t)strLen);
+        return jason_IndexFindKey(index, &key, elements);
+    }
+    
+    // like jason_IndexFind, for the elements with this number at the path
+    jasonSize jason_IndexFindInt64(const jasonValueIndex *index, int64_t number, jasonValue ***elements)
+    {
+        jasonIndexKey key;
+        memset(&key, 0, sizeof(jasonIndexKey));
+        key.Kind = jasonIndexKeyKind_Int64;
+        key.Bits = (uint64_t)number;
+        jason_HashNumberKey(index->Document, &key);
+        return jason_IndexFindKey(index, &key, elements);
+    }
+    
+    // defined with the writer
+    char *jason_FormatUint64(char *end, uint64_t value);
+    uint64_t jason_ShortestDecimal(uint64_t bits, int32_t *exponent);
+    
+    // the number is looked for as the shortest text that reads back as it, the way the writer puts it, so 0.1 finds
+    // 0.1 and 1e-1 but not the 0.1000000000000000055511151231257827021181583404541015625 the double holds.
+    // Infinities and NaN find nothing, JSON has no text for them
+    jasonSize jason_IndexFindDouble(const jasonValueIndex *index, double number, jasonValue ***elements)
+    {
+        *elements = NULL;
+        if(number != number || number - number != 0)
+        {
+            return 0;
+        }
+        
+        uint64_t bits;
+        memcpy(&bits, &number, sizeof(bits));
+        int32_t exponent = 0;
+        uint64_t decimal = ((bits << 1) != 0) ? jason_ShortestDecimal(bits, &exponent) : 0;
+        
+        // -digits e-exponent
+        char text[48];
+        char *it = text + sizeof(text);
+        it = jason_FormatUint64(it, (uint64_t)(exponent < 0 ? -(int64_t)exponent : exponent));
+        *--it = (exponent < 0) ? '-' : '+';
+        *--it = 'e';
+        it = jason_FormatUint64(it, decimal);
+        if(bits >> 63)
+        {
+            *--it = '-';
+        }
+        
+        jasonIndexKey key;
+        memset(&key, 0, sizeof(jasonIndexKey));
+        key.Text = it;
+        key.TextLen = (jasonSize)(text + sizeof(text) - it);
+        jason_NumberKey(index->Document, &key, number);
+        return jason_IndexFindKey(index, &key, elements);
+    }
+    
+    // like jason_IndexFind, for a string or number value from any document, such as the other side of a join
+    jasonSize jason_IndexFindValue(const jasonValueIndex *index, jasonValue *value, jasonValue ***elements)
+    {
+        jasonIndexKey key;
+        if(jason_IndexKeyOf(index->Document, value, &key) == jasonIndexKeyKind_None)
+        {
+            *elements = NULL;
+            return 0;
+        }
+        
+        return jason_IndexFindKey(index, &key, elements);
+    }
+    
+    // the elements of an index built with jasonIndexFlag_Sorted whose number at the path is from low to high, both
+    // included. Returns how many there are, *elements is set to the first of them and the others follow in numeric order
+    jasonSize jason_IndexRange(const jasonValueIndex *index, double low, double high, jasonValue ***elements)
+    {
+        jasonSize first = 0;
+        jasonSize last = index->NumSorted;
+        
+        // the first number no lower than low, then the first past high
+        for(jasonSize end = last; first < end;)
+        {
+            jasonSize middle = first + (end - first) / 2;
+            if(index->SortedNumbers[middle] < low)
+            {
+                first = middle + 1;
+            }
+            else
+            {
+                end = middle;
+            }
+        }
+        
+        for(jasonSize start = first; start < last;)
+        {
+            jasonSize middle = start + (last - start) / 2;
+            if(index->SortedNumbers[middle] <= high)
+            {
+                start = middle + 1;
+            }
+            else
+            {
+                last = middle;
+            }
+        }
+        
+        *elements = (last > first) ? index->Sorted + first : NULL;
+        return (last > first) ? last - first : 0;
+    }
+    
+    // subtree digests are the same for equal values whatever their whitespace and the order of their object keys, and
+    // comparable between all the documents of a process. Numbers hash their exact value, so 1, 1.0 and 1e0 agree while
+    // 9007199254740993 and 9007199254740992.0 do not: as the integer or double when one holds the value exactly, any
+    // other number as its digits and exponent. Other scalars hash their text as written. Arrays hash their elements in
+    // order and objects the sum of their members' hashes, which no order of the members changes
+    uint64_t jason_ScalarDigest(jasonValue *value)
+    {
+        jasonValueType type = jasonValue_GetType(value);
+        uint64_t seed = jason_HashSeed() + (uint64_t)type * 0x9E3779B97F4A7C15ull;
+        
+        const char *text = jasonValue_GetValue(value);
+        jasonSize len = jasonValue_GetValueLen(value);
+        if(type != jasonValueType_Number)
+        {
+            return jason_Hash64(text, (size_t)len, seed);
+        }
+        
+        // most numbers are short integers, read in one pass
+        int32_t negative = (*text == '-');
+        uint64_t bits = 0;
+        jasonSize i = negative;
+        while(i < len && i < 19 && JASON_ISDIGIT(text[i]))
+        {
+            bits = bits * 10 + (uint64_t)(text[i++] - '0');
+        }
+        
+        if(i == len && len > negative)
+        {
+            bits = negative ? 0 - bits : bits;
+            return jason_Hash64((const char*)&bits, sizeof(bits), seed + jasonIndexKeyKind_Int64);
+        }
+        
+        jasonDecimal decimal;
+        if(!jason_ReadDecimal(text, len, &decimal))
+        {
+            return jason_Hash64(text, (size_t)len, seed);
+        }
+        
+        jasonIndexKeyKind kind = jason_DecimalKey(&decimal, &bits);
+        if(kind != jasonIndexKeyKind_None)
+        {
+            return jason_Hash64((const char*)&bits, sizeof(bits), seed + kind);
+        }
+        
+        return jason_DecimalDigest(&decimal, seed + jasonIndexKeyKind_Decimal);
+    }
+    
+    // defined below, it works out the digests of a container's children
+    uint64_t jason_Digest(jason *jason, jasonValue *value);
+    
+    // digests: those of the container's children by tape index when all of them are known, NULL to work them out
+    uint64_t jason_ContainerDigest(jason *jason, jasonValue *container, const uint64_t *digests)
+    {
+        int32_t isObject = (jasonValue_GetType(container) == jasonValueType_Object);
+        uint64_t digest = jason_HashSeed() + (uint64_t)jasonValue_GetType(container) * 0x9E3779B97F4A7C15ull;
+        uint64_t members = 0;
+        uint64_t numChildren = 0;
+        
+        for(jasonValue *child = jasonValue_GetFirstChild(container); child != NULL; child = jasonValue_GetNextSibling(child), numChildren++)
+        {
+            uint64_t childDigest = (digests != NULL) ? digests[child - jason->RootValue] : jason_Digest(jason, child);
+            if(isObject)
+            {
+                uint64_t valueDigest = (digests != NULL) ? digests[child + 1 - jason->RootValue] : jason_Digest(jason, child + 1);
+                members += jason_HashMix(childDigest ^ 0xa0761d6478bd642full, valueDigest ^ 0xe7037ed1a0b428dbull);
+            }
+            else
+            {
+                digest = jason_HashMix(digest ^ childDigest, 0x8ebc6af09c88c6e3ull);
+            }
+        }
+        
+        return jason_HashMix(digest ^ members, numChildren ^ 0xe7037ed1a0b428dbull);
+    }
+    
+    // the digest of a value, from jason.Digests when it has one and worked out from its subtree otherwise. 0 for a
+    // container skipped by jasonFlag_Lazy that fails to expand
+    uint64_t jason_Digest(jason *jason, jasonValue *value)
+    {
+        if(value >= jason->RootValue && value < jason->RootValue + jason->NumDigests)
+        {
+            return jason->Digests[value - jason->RootValue];
+        }
+        
+        if(jasonValue_IsLazy(value))
+        {
+            value = jason_ResolveLazy(&jason, value);
+            return (value != NULL) ? jason_Digest(jason, value) : 0;
+        }
+        
+        jasonValueType type = jasonValue_GetType(value);
+        if(type == jasonValueType_Object || type == jasonValueType_Array)
+        {
+            return jason_ContainerDigest(jason, value, NULL);
+        }
+        
+        return jason_ScalarDigest(value);
+    }
+    
+    // the digest of every value of a parsed document, kept until jason_Reset or jason_Cleanup. What jasonFlag_Lazy
+    // skipped is expanded to be hashed
+    jasonStatus jason_ComputeDigests(jason *jason)
+    {
+        jasonStatus status = jason_GrowBuffer(jason, (void**)&jason->Digests, &jason->DigestsSize, jason->NumValues * sizeof(uint64_t));
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        // children follow their container on the tape, so walking it backwards finds their digests done
+        jason->NumDigests = 0;
+        for(jasonSize i = jason->NumValues - 1; i >= 0; i--)
+        {
+            jasonValue *value = jason->RootValue + i;
+            jasonValueType type = jasonValue_GetType(value);
+            
+            if(jasonValue_IsLazy(value))
+            {
+                jasonExpansion *expansion = NULL;
+                status = jason_Expand(jason, value, &expansion);
+                if(status == jasonStatus_Continue && expansion->Document.NumDigests == 0)
+                {
+                    status = jason_ComputeDigests(&expansion->Document);
+                    status = (status == jasonStatus_Finished) ? jasonStatus_Continue : status;
+                }
+                
+                if(status != jasonStatus_Continue)
+                {
+                    return status;
+                }
+                
+                jason->Digests[i] = expansion->Document.Digests[0];
+            }
+            else if(type == jasonValueType_Object || type == jasonValueType_Array)
+            {
+                jason->Digests[i] = jason_ContainerDigest(jason, value, jason->Digests);
+            }
+            else
+            {
+                jason->Digests[i] = jason_ScalarDigest(value);
+            }
+        }
+        
+        jason->NumDigests = jason->NumValues;
+        return jasonStatus_Finished;
+    }
+    
+    // whether two scalars of the same type are equal: numbers by their exact value as their digests are, the rest by
+    // their text
+    int32_t jason_SameScalar(jasonValue *valueA, jasonValue *valueB)
+    {
+        const char *textA = jasonValue_GetValue(valueA);
+        const char *textB = jasonValue_GetValue(valueB);
+        jasonSize lenA = jasonValue_GetValueLen(valueA);
+        jasonSize lenB = jasonValue_GetValueLen(valueB);
+        if(jasonValue_GetType(valueA) == jasonValueType_Number)
+        {
+            return jason_SameNumberText(textA, lenA, textB, lenB);
+        }
+        
+        return lenA == lenB && memcmp(textA, textB, (size_t)lenA) == 0;
+    }
+    
+    // walk two subtrees side by side, the check behind matching digests. Object members are matched by key, trying the
+    // member in the same place first as jason_Diff does
+    int32_t jason_SameValue(jason *a, jasonValue *valueA, jason *b, jasonValue *valueB)
+    {
+        jasonValueType type = jasonValue_GetType(valueA);
+        if(type != jasonValue_GetType(valueB))
+        {
+            return 0;
+        }
+        
+        if(type != jasonValueType_Object && type != jasonValueType_Array)
+        {
+            return jason_SameScalar(valueA, valueB);
+        }
+        
+        if(jasonValue_IsLazy(valueA) && valueB->ValueLen == valueA->ValueLen && memcmp(valueA->Value, valueB->Value, (size_t)-valueA->ValueLen) == 0)
+        {
+            // two containers jasonFlag_Lazy passed over with the same text, equal without expanding either
+            return 1;
+        }
+        
+        valueA = jason_ResolveLazy(&a, valueA);
+        valueB = jason_ResolveLazy(&b, valueB);
+        if(valueA == NULL || valueB == NULL || valueA->ValueLen != valueB->ValueLen)
+        {
+            return 0;
+        }
+        
+        jasonValue *childB = jasonValue_GetFirstChild(valueB);
+        for(jasonValue *childA = jasonValue_GetFirstChild(valueA); childA != NULL; childA = jasonValue_GetNextSibling(childA))
+        {
+            jasonValue *match = childB;
+            if(type == jasonValueType_Object)
+            {
+                jasonSize keyLen = jasonValue_GetValueLen(childA);
+                if(match == NULL || !jason_SameScalar(childA, match))
+                {
+                    match = jason_HashLookup(b, valueB, jasonValue_GetValue(childA), (int32_t)keyLen);
+                    match = (match != NULL) ? match - 1 : NULL;
+                }
+                
+                if(match == NULL || !jason_SameValue(a, childA + 1, b, match + 1))
+                {
+                    return 0;
+                }
+            }
+            else if(match == NULL || !jason_SameValue(a, childA, b, match))
+            {
+                return 0;
+            }
+            
+            childB = (childB != NULL) ? jasonValue_GetNextSibling(childB) : NULL;
+        }
+        
+        return 1;
+    }
+    
+    // whether two values, NULL for a document's root, are equal but for whitespace, the order of object keys and how
+    // numbers are written. Numbers compare by their exact value, not a rounded double: 1, 1.0 and 1e0 are equal, 1e400
+    // and 2e400 are not. Strings and keys are compared as written, escapes included, like lookups do, so "A" and
+    // "\u0041" differ. Different digests answer straight away, matching ones are confirmed by walking both subtrees so
+    // no collision passes. Documents get their digests first, if that runs out of memory the values are hashed on every
+    // call instead
+    int32_t jason_Equal(jason *a, jasonValue *valueA, jason *b, jasonValue *valueB)
+    {
+        if(a->NumDigests == 0)
+        {
+            jason_ComputeDigests(a);
+        }
+        
+        if(b->NumDigests == 0)
+        {
+            jason_ComputeDigests(b);
+        }
+        
+        valueA = (valueA != NULL) ? valueA : a->RootValue;
+        valueB = (valueB != NULL) ? valueB : b->RootValue;
+        if(valueA == NULL || valueB == NULL || jason_Digest(a, valueA) != jason_Digest(b, valueB))
+        {
+            return 0;
+        }
+        
+        return jason_SameValue(a, valueA, b, valueB);
+    }
+    
+    // append "/segment" to the path, with ~ and / escaped as RFC 6901 asks
+    jasonStatus jason_PushDiffPath(jasonDiff *diff, const char *segment, size_t segmentLen)
+    {
+        jasonStatus status = jason_GrowBuffer(diff->Allocator, (void**)&diff->Path, &diff->PathSize, diff->PathLen + segmentLen * 2 + 2);
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        diff->Path[diff->PathLen++] = '/';
+        for(size_t i = 0; i < segmentLen; i++)
+        {
+            if(segment[i] == '~' || segment[i] == '/')
+            {
+                diff->Path[diff->PathLen++] = '~';
+                diff->Path[diff->PathLen++] = (segment[i] == '~') ? '0' : '1';
+            }
+            else
+            {
+                diff->Path[diff->PathLen++] = segment[i];
+            }
+        }
+        
+        diff->Path[diff->PathLen] = '\0';
+        return jasonStatus_Continue;
+    }
+    
+    jasonStatus jason_ReportDiff(jasonDiff *diff, jasonDiffKind kind, jasonValue *before, jasonValue *after)
+    {
+        return diff->Callback(diff->Context, kind, (diff->Path != NULL) ? diff->Path : "", diff->PathLen, before, after);
+    }
+    
+    jasonStatus jason_DiffValues(jasonDiff *diff, jason *before, jasonValue *beforeValue, jason *after, jasonValue *afterValue)
+    {
+        if(jason_Digest(before, beforeValue) == jason_Digest(after, afterValue) && jason_SameValue(before, beforeValue, after, afterValue))
+        {
+            return jasonStatus_Continue;
+        }
+        
+        jasonValueType type = jasonValue_GetType(beforeValue);
+        if(type != jasonValue_GetType(afterValue) || (type != jasonValueType_Object && type != jasonValueType_Array))
+        {
+            return jason_ReportDiff(diff, jasonDiffKind_Changed, beforeValue, afterValue);
+        }
+        
+        beforeValue = jason_ResolveLazy(&before, beforeValue);
+        afterValue = jason_ResolveLazy(&after, afterValue);
+        if(beforeValue == NULL || afterValue == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        jasonStatus status = jasonStatus_Continue;
+        size_t pathLen = diff->PathLen;
+        
+        if(type == jasonValueType_Object)
+        {
+            // members are matched by key, the ones only on the new side come last. A config usually keeps its key
+            // order, so the member in the same place on the other side is tried first, by the digests of the keys
+            jasonValue *other = jasonValue_GetFirstChild(afterValue);
+            int32_t inStep = 1;
+            for(jasonValue *key = jasonValue_GetFirstChild(beforeValue); key != NULL && status == jasonStatus_Continue; key = jasonValue_GetNextSibling(key))
+            {
+                const char *keyStr = jasonValue_GetValue(key);
+                jasonSize keyLen = jasonValue_GetValueLen(key);
+                jasonValue *match = (other != NULL && jason_Digest(after, other) == jason_Digest(before, key) && jason_SameScalar(other, key)) ? other + 1 : NULL;
+                if(match == NULL)
+                {
+                    inStep = 0;
+                    match = jason_HashLookup(after, afterValue, keyStr, (int32_t)keyLen);
+                }
+                
+                other = (other != NULL) ? jasonValue_GetNextSibling(other) : NULL;
+                
+                if(match != NULL && jason_Digest(before, key + 1) == jason_Digest(after, match) && jason_SameValue(before, key + 1, after, match))
+                {
+                    continue;
+                }
+                
+                status = jason_PushDiffPath(diff, keyStr, (size_t)keyLen);
+                if(status == jasonStatus_Continue)
+                {
+                    status = (match != NULL) ? jason_DiffValues(diff, before, key + 1, after, match) : jason_ReportDiff(diff, jasonDiffKind_Removed, key + 1, NULL);
+                }
+                
+                diff->PathLen = pathLen;
+            }
+            
+            // with every key in the same place on both sides, none can be new
+            inStep = inStep && other == NULL;
+            other = jasonValue_GetFirstChild(beforeValue);
+            for(jasonValue *key = inStep ? NULL : jasonValue_GetFirstChild(afterValue); key != NULL && status == jasonStatus_Continue; key = jasonValue_GetNextSibling(key))
+            {
+                const char *keyStr = jasonValue_GetValue(key);
+                jasonSize keyLen = jasonValue_GetValueLen(key);
+                int32_t isNew = !(other != NULL && jason_Digest(before, other) == jason_Digest(after, key) && jason_SameScalar(other, key)) && jason_HashLookup(before, beforeValue, keyStr, (int32_t)keyLen) == NULL;
+                other = (other != NULL) ? jasonValue_GetNextSibling(other) : NULL;
+                
+                if(isNew)
+                {
+                    status = jason_PushDiffPath(diff, keyStr, (size_t)keyLen);
+                    if(status == jasonStatus_Continue)
+                    {
+                        status = jason_ReportDiff(diff, jasonDiffKind_Added, NULL, key + 1);
+                    }
+                    
+                    diff->PathLen = pathLen;
+                }
+            }
+            
+            return status;
+        }
+        
+        // elements are matched by position
+        jasonValue *beforeChild = jasonValue_GetFirstChild(beforeValue);
+        jasonValue *afterChild = jasonValue_GetFirstChild(afterValue);
+        for(uint64_t i = 0; (beforeChild != NULL || afterChild != NULL) && status == jasonStatus_Continue; i++)
+        {
+            char digits[24];
+            char *start = jason_FormatUint64(digits + sizeof(digits), i);
+            status = jason_PushDiffPath(diff, start, (size_t)(digits + sizeof(digits) - start));
+            
+            if(status == jasonStatus_Continue)
+            {
+                if(beforeChild == NULL)
+                {
+                    status = jason_ReportDiff(diff, jasonDiffKind_Added, NULL, afterChild);
+                }
+                else if(afterChild == NULL)
+                {
+                    status = jason_ReportDiff(diff, jasonDiffKind_Removed, beforeChild, NULL);
+                }
+                else
+                {
+                    status = jason_DiffValues(diff, before, beforeChild, after, afterChild);
+                }
+            }
+            
+            diff->PathLen = pathLen;
+            beforeChild = (beforeChild != NULL) ? jasonValue_GetNextSibling(beforeChild) : NULL;
+            afterChild = (afterChild != NULL) ? jasonValue_GetNextSibling(afterChild) : NULL;
+        }
+        
+        return status;
+    }
+    
+    // report how two values differ, NULL for a document's root, descending only into the containers that differ.
+    // Objects are matched by key and arrays by position, so an element inserted into an array changes the ones after
+    // it. A subtree is passed over when its digests match and a walk of both sides confirms it, so no collision hides
+    // a change; the cost is that walk over what is equal, plus the width of the containers on the way to each
+    // difference
+    jasonStatus jason_Diff(jason *before, jasonValue *beforeValue, jason *after, jasonValue *afterValue, jasonDiffCb_t callback, void *context)
+    {
+        if(before->NumValues == 0 || after->NumValues == 0)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        jasonStatus status = (before->NumDigests == 0) ? jason_ComputeDigests(before) : jasonStatus_Finished;
+        if(status == jasonStatus_Finished && after->NumDigests == 0)
+        {
+            status = jason_ComputeDigests(after);
+        }
+        
+        if(status != jasonStatus_Finished)
+        {
+            return status;
+        }
+        
+        jasonDiff diff;
+        memset(&diff, 0, sizeof(jasonDiff));
+        diff.Callback = callback;
+        diff.Context = context;
+        diff.Allocator = before;
+        
+        status = jason_DiffValues(&diff, before, (beforeValue != NULL) ? beforeValue : before->RootValue, after, (afterValue != NULL) ? afterValue : after->RootValue);
+        before->Free(diff.Path);
+        return (status == jasonStatus_Continue) ? jasonStatus_Finished : status;
+    }
+    
+    void jasonProjection_Free(jasonProjection *projection)
+    {
+        jason_Free(projection->Nodes);
+        jason_Free(projection->Text);
+        memset(projection, 0, sizeof(jasonProjection));
+    }
+    
+    // defined below, it fills a new key from the wildcard beside it
+    jasonStatus jasonProjection_Merge(jasonProjection *projection, int32_t from, int32_t into);
+    
+    // the child of 'node' for a key already in Text at keyOffset, added if there is none. A wildcard stays the last
+    // child, so keys and indexes are tried before it, and a new key starts with a copy of what is under the wildcard:
+    // the first child a value matches keeps everything any of the paths lead to. -1 when out of memory
+    int32_t jasonProjection_AddChild(jasonProjection *projection, int32_t node, size_t keyOffset, int32_t keyLen, int32_t index, int32_t wildcard)
+    {
+        int32_t wildcardChild = -1;
+        for(int32_t child = projection->Nodes[node].FirstChild; child >= 0; child = projection->Nodes[child].NextSibling)
+        {
+            const jasonProjectionNode *existing = projection->Nodes + child;
+            if(existing->Wildcard == wildcard && existing->KeyLen == keyLen && (keyLen == 0 || memcmp(projection->Text + existing->KeyOffset, projection->Text + keyOffset, keyLen) == 0))
+            {
+                return child;
+            }
+            
+            wildcardChild = existing->Wildcard ? child : wildcardChild;
+        }
+        
+        if(projection->NumNodes == projection->NodesSize)
+        {
+            size_t memLength = projection->NodesSize * 2 * sizeof(jasonProjectionNode);
+            jasonProjectionNode *newNodes = jason_Realloc(projection->Nodes, &memLength);
+            if(newNodes == NULL)
+            {
+                return -1;
+            }
+            
+            projection->Nodes = newNodes;
+            projection->NodesSize = (int32_t)(memLength / sizeof(jasonProjectionNode));
+        }
+        
+        int32_t child = projection->NumNodes++;
+        jasonProjectionNode *added = projection->Nodes + child;
+        added->KeyOffset = keyOffset;
+        added->KeyLen = keyLen;
+        added->Index = index;
+        added->Wildcard = wildcard;
+        added->FirstChild = -1;
+        added->KeepAll = 0;
+        if(keyOffset == projection->TextUsed)
+        {
+            projection->TextUsed += keyLen;
+        }
+        
+        int32_t *link = &projection->Nodes[node].FirstChild;
+        while(*link >= 0 && !projection->Nodes[*link].Wildcard)
+        {
+            link = &projection->Nodes[*link].NextSibling;
+        }
+        
+        added->NextSibling = *link;
+        *link = child;
+        
+        if(!wildcard && wildcardChild >= 0 && jasonProjection_Merge(projection, wildcardChild, child) != jasonStatus_Continue)
+        {
+            return -1;
+        }
+        
+        return child;
+    }
+    
+    // add everything under 'from' to 'into', and what is under a wildcard child to the keys beside it as well
+    jasonStatus jasonProjection_Merge(jasonProjection *projection, int32_t from, int32_t into)
+    {
+        projection->Nodes[into].KeepAll |= projection->Nodes[from].KeepAll;
+        
+        for(int32_t child = projection->Nodes[from].FirstChild; child >= 0; child = projection->Nodes[child].NextSibling)
+        {
+            jasonProjectionNode copy = projection->Nodes[child];
+            int32_t target = jasonProjection_AddChild(projection, into, copy.KeyOffset, copy.KeyLen, copy.Index, copy.Wildcard);
+            if(target < 0 || jasonProjection_Merge(projection, child, target) != jasonStatus_Continue)
+            {
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            for(int32_t sibling = projection->Nodes[into].FirstChild; copy.Wildcard && sibling >= 0; sibling = projection->Nodes[sibling].NextSibling)
+            {
+                if(sibling != target && jasonProjection_Merge(projection, child, sibling) != jasonStatus_Continue)
+                {
+                    return jasonStatus_Break(jasonStatus_OutOfMemory);
+                }
+            }
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    jasonStatus jasonProjection_AddSegments(jasonProjection *projection, int32_t node, const jasonPathSegment *segments, int32_t numSegments)
+    {
+        if(numSegments == 0)
+        {
+            projection->Nodes[node].KeepAll = 1;
+            return jasonStatus_Continue;
+        }
+        
+        const jasonKey *key = &segments->Key;
+        if(projection->TextUsed + key->KeyLen > projection->TextSize)
+        {
+            size_t memLength = projection->TextSize > 0 ? projection->TextSize : 256;
+            while(memLength < projection->TextUsed + key->KeyLen)
+            {
+                memLength *= 2;
+            }
+            
+            char *newText = jason_Realloc(projection->Text, &memLength);
+            if(newText == NULL)
+            {
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            projection->Text = newText;
+            projection->TextSize = memLength;
+        }
+        
+        // written past the end of the text, kept only if a node is added for it
+        memcpy(projection->Text + projection->TextUsed, key->Key, key->KeyLen);
+        int32_t wildcard = (key->KeyLen == 1 && key->Key[0] == '*');
+        int32_t child = jasonProjection_AddChild(projection, node, projection->TextUsed, key->KeyLen, segments->Index, wildcard);
+        jasonStatus status = (child >= 0) ? jasonProjection_AddSegments(projection, child, segments + 1, numSegments - 1) : jasonStatus_Break(jasonStatus_OutOfMemory);
+        
+        // a path through the wildcard also leads through every key beside it
+        for(int32_t sibling = projection->Nodes[node].FirstChild; wildcard && status == jasonStatus_Continue && sibling >= 0; sibling = projection->Nodes[sibling].NextSibling)
+        {
+            if(sibling != child)
+            {
+                status = jasonProjection_AddSegments(projection, sibling, segments + 1, numSegments - 1);
+            }
+        }
+        
+        return status;
+    }
+    
+    // keep the values 'path' leads to, and everything inside them. A "*" segment matches any key or array element,
+    // and where a key or index also has paths of its own, its values keep the union of both
+    jasonStatus jasonProjection_AddPath(jasonProjection *projection, const jasonPath *path)
+    {
+        if(projection->NumNodes == 0)
+        {
+            size_t memLength = 16 * sizeof(jasonProjectionNode);
+            projection->Nodes = jason_Malloc(&memLength);
+            if(projection->Nodes == NULL || memLength < 16 * sizeof(jasonProjectionNode))
+            {
+                jason_Free(projection->Nodes);
+                projection->Nodes = NULL;
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            memset(projection->Nodes, 0, sizeof(jasonProjectionNode));
+            projection->Nodes[0].FirstChild = -1;
+            projection->Nodes[0].NextSibling = -1;
+            projection->Nodes[0].Index = -1;
+            projection->NodesSize = (int32_t)(memLength / sizeof(jasonProjectionNode));
+            projection->NumNodes = 1;
+        }
+        
+        return jasonProjection_AddSegments(projection, 0, path->Segments, path->NumSegments);
+    }
+    
+    // add several JSON Pointers at once, such as "/Users/*/Name" and "/Users/*/Age"
+    jasonStatus jasonProjection_Compile(jasonProjection *projection, const char **pointers, int32_t numPointers)
+    {
+        memset(projection, 0, sizeof(jasonProjection));
+        
+        for(int32_t i = 0; i < numPointers; i++)
+        {
+            jasonPath path;
+            jasonStatus status = jasonPath_Compile(&path, pointers[i], (int32_t)strlen(pointers[i]), NULL);
+            if(status == jasonStatus_Continue)
+            {
+                status = jasonProjection_AddPath(projection, &path);
+            }
+            
+            jasonPath_Free(&path);
+            if(status != jasonStatus_Continue)
+            {
+                jasonProjection_Free(projection);
+                return status;
+            }
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    jasonStatus jason_Begin(jason *jason)
+    {
+        if(jason->Malloc == NULL || jason->Free == NULL)
+        {
+            jason->Malloc = jason_Malloc;
+            jason->Free = jason_Free;
+            jason->Realloc = jason_Realloc;
+        }
+        
+        if(jason->Hash == NULL)
+        {
+            jason->Hash = jason_Hash;
+        }
+        
+        if(jason->HashSeed == 0)
+        {
+            jason->HashSeed = jason_HashSeed();
+        }
+        
+        // alloc initial memory, anything kept by jason_Reset is reused
+        jason_Reset(jason);
+        return jason_ReserveValues(jason, jason->ExpectedValues > 32 ? jason->ExpectedValues : 32);
+    }
+    
+    jasonStatus jason_Feed(jason *jason, const char *chunk, jasonSize chunkLen)
+    {
+        if(chunk == NULL || chunkLen <= 0)
+        {
+            return jasonStatus_Continue;
+        }
+        
+        jasonSourceBlock *block = jason->SourceBlocks;
+        
+        if(block != NULL && jason->ParsePosition == NULL)
+        {
+            // first chunk into a block kept by jason_Reset
+            jason->ParsePosition = JASON_SOURCEBLOCK_DATA(block) + block->Used;
+        }
+        
+        if(block == NULL || block->Size - block->Used < (size_t)chunkLen)
+        {
+            // values keep pointing into full blocks, only an unfinished token is carried over so it stays contiguous
+            const char *carry = jason->ParsePosition;
+            int32_t inToken = (jason->ParseState == jasonParseState_String || jason->ParseState == jasonParseState_Literal || jason->ParseState == jasonParseState_Number);
+            if(inToken)
+            {
+                carry = jason->RootValue[jason->NumValues - 1].Value;
+            }
+            
+            size_t carryLen = (block != NULL) ? (size_t)(JASON_SOURCEBLOCK_DATA(block) + block->Used - carry) : 0;
+            size_t resume = (block != NULL) ? (size_t)(jason->ParsePosition - carry) : 0;
+            size_t dataLen = carryLen + chunkLen > JASON_SOURCEBLOCK_SIZE ? carryLen + chunkLen : JASON_SOURCEBLOCK_SIZE;
+            size_t memLength = sizeof(jasonSourceBlock) + dataLen;
+            jasonSourceBlock *newBlock = jason->Malloc(&memLength);
+            
+            if(newBlock == NULL || memLength < sizeof(jasonSourceBlock) + carryLen + chunkLen)
+            {
+                jason->Free(newBlock);
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            newBlock->Prev = block;
+            newBlock->Size = memLength - sizeof(jasonSourceBlock);
+            newBlock->Used = carryLen;
+            JASON_STATS_ADD(jason, SourceBlocks, 1);
+            JASON_STATS_ADD(jason, CarriedBytes, carryLen);
+            
+            char *data = JASON_SOURCEBLOCK_DATA(newBlock);
+            if(carryLen > 0)
+            {
+                memcpy(data, carry, carryLen);
+            }
+            
+            if(inToken)
+            {
+                jason->RootValue[jason->NumValues - 1].Value = data;
+            }
+            
+            jason->ParsePosition = data + resume;
+            jason->SourceBlocks = newBlock;
+            block = newBlock;
+        }
+        
+        char *data = JASON_SOURCEBLOCK_DATA(block);
+        memcpy(data + block->Used, chunk, chunkLen);
+        block->Used += chunkLen;
+        
+        JASON_STATS_STAGE(jason, jasonStage_Parse, 0);
+        jasonStatus status = jason_DeserializeStep(jason, data + block->Used, 0);
+        JASON_STATS_STAGE(jason, jasonStage_Parse, 1);
+        
+        if(status == jasonStatus_Continue && jason->ParseState == jasonParseState_Done)
+        {
+            return jasonStatus_Finished;
+        }
+        
+        return status;
+    }
+    
+    jasonStatus jason_End(jason *jason)
+    {
+        jasonSourceBlock *block = jason->SourceBlocks;
+        if(block == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        JASON_STATS_STAGE(jason, jasonStage_Parse, 0);
+        jasonStatus status = jason_DeserializeStep(jason, JASON_SOURCEBLOCK_DATA(block) + block->Used, 1);
+        JASON_STATS_STAGE(jason, jasonStage_Parse, 1);
+        return status;
+    }
+    
+    jasonStatus jason_Deserialize(jason *jason, const char *json, jasonSize jsonLen)
+    {
+        if(json == NULL || jsonLen <= 0)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        jasonStatus status = jason_Begin(jason);
+        jason->ParsePosition = json;
+        
+        if(status == jasonStatus_Continue && (jason->Flags & jasonFlag_PreCount))
+        {
+            JASON_STATS_STAGE(jason, jasonStage_PreCount, 0);
+            status = jason_ReserveValues(jason, jason_CountValues(json, jsonLen));
+            JASON_STATS_STAGE(jason, jasonStage_PreCount, 1);
+        }
+        
+        if(status == jasonStatus_Continue && (jason->Flags & jasonFlag_StructuralIndex))
+        {
+            JASON_STATS_STAGE(jason, jasonStage_StructuralIndex, 0);
+            status = jason_BuildStructuralIndex(jason, json, jsonLen);
+            JASON_STATS_STAGE(jason, jasonStage_StructuralIndex, 1);
+        }
+        
+        if(status == jasonStatus_Continue)
+        {
+            JASON_STATS_STAGE(jason, jasonStage_Parse, 0);
+            status = jason_DeserializeStep(jason, json + jsonLen, 1);
+            JASON_STATS_STAGE(jason, jasonStage_Parse, 1);
+        }
+        
+        jason->Free(jason->StructuralIndex.Positions);
+        jason->StructuralIndex.Positions = NULL;
+        
+        if(status == jasonStatus_Finished)
+        {
+            jason->ParsePosition = json;
+        }
+        else
+        {
+            if(jason->RootValue != NULL)
+            {
+                jason->Free(jason->RootValue);
+                jason->RootValue = NULL;
+            }
+        }
+        
+        return status;
+    }
+    
+    // parse the children of a container skipped by jasonFlag_Lazy into a document of their own, once. The containers inside
+    // are skipped in turn, so each expansion costs one level of the tree
+    jasonStatus jason_Expand(jason *jason, jasonValue *container, jasonExpansion **expansion)
+    {
+        uint32_t mask = (uint32_t)jason->ExpansionsSize - 1;
+        uint32_t hash = (uint32_t)(((uintptr_t)container / sizeof(jasonValue)) * 2654435761u);
+        
+        for(uint32_t slot = hash & mask; jason->ExpansionsSize > 0 && jason->Expansions[slot] != NULL; slot = (slot + 1) & mask)
+        {
+            if(jason->Expansions[slot]->Container == container)
+            {
+                *expansion = jason->Expansions[slot];
+                return jasonStatus_Continue;
+            }
+        }
+        
+        if((jason->NumExpansions + 1) * 2 > jason->ExpansionsSize)
+        {
+            int32_t newSize = jason->ExpansionsSize > 0 ? jason->ExpansionsSize * 2 : 16;
+            size_t memLength = newSize * sizeof(jasonExpansion*);
+            jasonExpansion **newTable = jason->Malloc(&memLength);
+            
+            if(newTable == NULL || memLength < newSize * sizeof(jasonExpansion*))
+            {
+                jason->Free(newTable);
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            memset(newTable, 0, newSize * sizeof(jasonExpansion*));
+            for(int32_t i = 0; i < jason->ExpansionsSize; i++)
+            {
+                jasonExpansion *entry = jason->Expansions[i];
+                if(entry != NULL)
+                {
+                    uint32_t slot = (uint32_t)(((uintptr_t)entry->Container / sizeof(jasonValue)) * 2654435761u) & (uint32_t)(newSize - 1);
+                    while(newTable[slot] != NULL)
+                    {
+                        slot = (slot + 1) & (uint32_t)(newSize - 1);
+                    }
+                    
+                    newTable[slot] = entry;
+                }
+            }
+            
+            jason->Free(jason->Expansions);
+            jason->Expansions = newTable;
+            jason->ExpansionsSize = newSize;
+            mask = (uint32_t)newSize - 1;
+        }
+        
+        size_t memLength = sizeof(jasonExpansion);
+        jasonExpansion *entry = jason->Malloc(&memLength);
+        if(entry == NULL || memLength < sizeof(jasonExpansion))
+        {
+            jason->Free(entry);
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        memset(entry, 0, sizeof(jasonExpansion));
+        entry->Container = container;
+        entry->Document.Malloc = jason->Malloc;
+        entry->Document.Free = jason->Free;
+        entry->Document.Realloc = jason->Realloc;
+        entry->Document.Hash = jason->Hash;
+        entry->Document.HashSeed = jason->HashSeed;
+        entry->Document.Flags = jason->Flags | jasonFlag_Lazy;
+#ifdef JASON_STATS
+        entry->Document.Stats = jason->Stats;
+#endif
+        
+        jasonStatus status = jason_Deserialize(&entry->Document, container->Value, -container->ValueLen);
+        if(status != jasonStatus_Finished)
+        {
+            jason_Cleanup(&entry->Document);
+            jason->Free(entry);
+            return status;
+        }
+        
+        uint32_t slot = hash & mask;
+        while(jason->Expansions[slot] != NULL)
+        {
+            slot = (slot + 1) & mask;
+        }
+        
+        jason->Expansions[slot] = entry;
+        jason->NumExpansions++;
+        *expansion = entry;
+        return jasonStatus_Continue;
+    }
+    
+    // parse without a tape, handing every value to the handler as it is read. Nothing is allocated: the open containers are
+    // kept one bit per level on the C stack, and the values passed on point into json
+    jasonStatus jason_DeserializeSax(jasonSaxHandler *handler, const char *json, jasonSize jsonLen)
+    {
+        uint64_t objects[JASON_SAX_STACK_WORDS]; // bit set for an object, clear for an array
+        int32_t maxDepth = (handler->MaxDepth > 0 && handler->MaxDepth < JASON_DEFAULT_MAX_DEPTH) ? handler->MaxDepth : JASON_DEFAULT_MAX_DEPTH;
+        int32_t depth = 0;
+        int32_t needKey = 0; // straight after the '{' of an object or one of its commas
+        int32_t separated = 0; // straight after a comma, for jasonFlag_Strict
+        jasonParseState state = jasonParseState_Value;
+        jasonStatus status = jasonStatus_Continue;
+        const char *str = json;
+        const char *strEnd = json + (json != NULL && jsonLen > 0 ? jsonLen : 0);
+        
+        while(status == jasonStatus_Continue)
+        {
+            JASON_SKIPWHITESPACE(str, strEnd);
+            
+            if(str >= strEnd)
+            {
+                status = (state == jasonParseState_Done) ? jasonStatus_Finished : jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+                break;
+            }
+            
+            int32_t isObject = depth > 0 && ((objects[(depth - 1) / 64] >> ((depth - 1) % 64)) & 1);
+            char closer = isObject ? '}' : ']';
+            
+            if(state == jasonParseState_Done)
+            {
+                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                break;
+            }
+            
+            if(state == jasonParseState_KeySeparator)
+            {
+                if(*str != ':')
+                {
+                    status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    break;
+                }
+                
+                str++;
+                state = jasonParseState_Value;
+                continue;
+            }
+            
+            if(state == jasonParseState_ValueSeparator)
+            {
+                if(*str == ',')
+                {
+                    str++;
+                    needKey = isObject;
+                    separated = 1;
+                    state = jasonParseState_Value;
+                    continue;
+                }
+                
+                if(*str != closer)
+                {
+                    status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                    break;
+                }
+            }
+            else if(depth == 0 || *str != closer || (isObject && !needKey))
+            {
+                // a value, or for an object its key
+                jasonSaxValueCb_t callback = NULL;
+                jasonValue value;
+                value.Value = str;
+                value.ValueLen = 0;
+                value.Next = 0;
+                
+                switch(*str)
+                {
+                    case '{':
+                    case '[':
+                    {
+                        if(needKey)
+                        {
+                            status = jasonStatus_Break(jasonStatus_ExpectedObjectKey);
+                            break;
+                        }
+                        
+                        if(depth >= maxDepth)
+                        {
+                            status = jasonStatus_Break(jasonStatus_MaxDepthExceeded);
+                            break;
+                        }
+                        
+                        uint64_t bit = (uint64_t)1 << (depth % 64);
+                        objects[depth / 64] = (*str == '{') ? (objects[depth / 64] | bit) : (objects[depth / 64] & ~bit);
+                        depth++;
+                        needKey = (*str == '{');
+                        separated = 0;
+                        
+                        jasonSaxCb_t open = needKey ? handler->StartObject : handler->StartArray;
+                        str++;
+                        status = open != NULL ? open(handler->Context) : jasonStatus_Continue;
+                        continue;
+                    }
+                        
+                    case '"':
+                    {
+                        const char *end = NULL;
+                        if(handler->Flags & jasonFlag_Strict)
+                        {
+                            const char *it = str + 1;
+                            int32_t checkUtf8 = 0;
+                            status = jason_ScanStrictString(&value, &it, strEnd, &checkUtf8);
+                            if(status == jasonStatus_Continue && (it >= strEnd || *it != '"'))
+                            {
+                                status = jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+                            }
+                            else if(status == jasonStatus_Continue && checkUtf8 && !jason_SelectStringChecker()(str + 1, it - str - 1))
+                            {
+                                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            }
+                            
+                            if(status != jasonStatus_Continue)
+                            {
+                                str = it;
+                                break;
+                            }
+                            
+                            end = it + 1;
+                        }
+                        else
+                        {
+                            end = jason_SkipString(str, strEnd);
+                            if(end == NULL)
+                            {
+                                status = jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+                                break;
+                            }
+                            
+                            value.ValueLen = (memchr(str + 1, '\\', end - str - 2) != NULL) ? JASON_STRING_ESCAPED : 0;
+                        }
+                        
+                        if(end - str > JASON_VALUELEN_MASK)
+                        {
+                            status = jasonStatus_Break(jasonStatus_IntegerOverflow);
+                            break;
+                        }
+                        
+                        // the escape flag was left in the value by the scan
+                        value.ValueLen |= (jasonSize)(end - str);
+                        callback = needKey ? handler->Key : handler->String;
+                        str = end;
+                        break;
+                    }
+                        
+                    case 't':
+                    case 'f':
+                    case 'n':
+                    {
+                        const char *literal = (*str == 't') ? "true" : (*str == 'f') ? "false" : "null";
+                        int32_t literalLen = (int32_t)strlen(literal);
+                        int32_t available = (strEnd - str < literalLen) ? (int32_t)(strEnd - str) : literalLen;
+                        
+                        if(strncmp(str, literal, available) != 0)
+                        {
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                        
+                        if(available < literalLen)
+                        {
+                            str = strEnd;
+                            status = jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+                            break;
+                        }
+                        
+                        value.ValueLen = literalLen;
+                        callback = (*str == 'n') ? handler->Null : handler->Bool;
+                        str += literalLen;
+                        break;
+                    }
+                        
+                    default:
+                    {
+                        if(!JASON_ISDIGIT(*str) && *str != '-')
+                        {
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                        
+                        const char *end = str;
+                        if(handler->Flags & jasonFlag_Strict)
+                        {
+                            // what is left of a number written loosely is rejected as the next token
+                            const char *stop = NULL;
+                            end = jason_ScanNumber(str, strEnd, &stop);
+                            if(end == str)
+                            {
+                                str = stop;
+                                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            while(end < strEnd && (JASON_ISDIGIT(*end) || *end == '.' || *end == 'E' || *end == 'e' || *end == '-' || *end == '+'))
+                            {
+                                end++;
+                            }
+                            
+                            if(!JASON_ISDIGIT(end[-1]))
+                            {
+                                str = end;
+                                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                                break;
+                            }
+                        }
+                        
+                        jasonNumber number;
+                        value.ValueLen = (jasonSize)(end - str);
+                        if((handler->Flags & jasonFlag_DecodeNumbers) && jason_ParseNumber(str, value.ValueLen, &number) != jasonStatus_Finished)
+                        {
+                            status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                            break;
+                        }
+                        
+                        if(!needKey)
+                        {
+                            str = end;
+                            if(handler->Number != NULL)
+                            {
+                                status = handler->Number(handler->Context, &value, (handler->Flags & jasonFlag_DecodeNumbers) ? &number : NULL);
+                            }
+                        }
+                        
+                        break;
+                    }
+                }
+                
+                if(status != jasonStatus_Continue)
+                {
+                    break;
+                }
+                
+                if(needKey && *value.Value != '"')
+                {
+                    str = value.Value;
+                    status = jasonStatus_Break(jasonStatus_ExpectedObjectKey);
+                    break;
+                }
+                
+                if(callback != NULL)
+                {
+                    status = callback(handler->Context, &value);
+                }
+                
+                state = needKey ? jasonParseState_KeySeparator : (depth > 0 ? jasonParseState_ValueSeparator : jasonParseState_Done);
+                needKey = 0;
+                separated = 0;
+                continue;
+            }
+            
+            if(separated && (handler->Flags & jasonFlag_Strict))
+            {
+                // a trailing comma
+                status = jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+                break;
+            }
+            
+            // the closing bracket of the innermost container
+            jasonSaxCb_t close = isObject ? handler->EndObject : handler->EndArray;
+            str++;
+            depth--;
+            state = depth > 0 ? jasonParseState_ValueSeparator : jasonParseState_Done;
+            needKey = 0;
+            status = close != NULL ? close(handler->Context) : jasonStatus_Continue;
+        }
+        
+        handler->Position = str;
+        return status;
+    }
+    
+    // fallback for systems without mmap, or files that cannot be mapped
+    jasonStatus jason_ReadFile(jason *jason, FILE *file, size_t fileSize)
+    {
+        size_t memLength = fileSize;
+        jason->File = jason->Malloc(&memLength);
+        if(jason->File == NULL || memLength < fileSize)
+        {
+            jason->Free(jason->File);
+            jason->File = NULL;
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        jason->FileSize = fileSize;
+        jason->FileMapped = 0;
+        
+        if(fread(jason->File, 1, fileSize, file) != fileSize)
+        {
+            jason_ReleaseFile(jason);
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    // map or read a whole file into jason->File, refusing one of maxSize bytes or more
+    jasonStatus jason_OpenFile(jason *jason, const char *path, uint64_t maxSize)
+    {
+        jasonStatus status = jasonStatus_Continue;
+        
+#ifdef JASON_MMAP
+        int fd = open(path, O_RDONLY);
+        if(fd < 0)
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        struct stat info;
+        if(fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            close(fd);
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        if((uint64_t)info.st_size >= maxSize)
+        {
+            close(fd);
+            return jasonStatus_Break(jasonStatus_IntegerOverflow);
+        }
+        
+        size_t fileSize = (size_t)info.st_size;
+        int mapFlags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        // fault the whole file in up front rather than one page at a time during the parse
+        mapFlags |= MAP_POPULATE;
+#endif
+        void *mapping = mmap(NULL, fileSize, PROT_READ, mapFlags, fd, 0);
+        close(fd);
+        
+        if(mapping != MAP_FAILED)
+        {
+            jason->File = mapping;
+            jason->FileSize = fileSize;
+            jason->FileMapped = 1;
+            
+            // the hints below need the system extensions, _DEFAULT_SOURCE under a strict -std
+#ifdef MADV_SEQUENTIAL
+            madvise(mapping, fileSize, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_HUGEPAGE
+            if(jason->Flags & jasonFlag_HugePages)
+            {
+                madvise(mapping, fileSize, MADV_HUGEPAGE);
+            }
+#endif
+        }
+        else
+        {
+            FILE *file = fopen(path, "rb");
+            status = (file != NULL) ? jason_ReadFile(jason, file, fileSize) : jasonStatus_Break(jasonStatus_FileError);
+            if(file != NULL)
+            {
+                fclose(file);
+            }
+        }
+#else
+        FILE *file = fopen(path, "rb");
+        if(file == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        long fileSize = -1;
+        if(fseek(file, 0, SEEK_END) == 0)
+        {
+            fileSize = ftell(file);
+            rewind(file);
+        }
+        
+        if(fileSize <= 0 || (uint64_t)fileSize >= maxSize)
+        {
+            fclose(file);
+            return jasonStatus_Break(fileSize > 0 ? jasonStatus_IntegerOverflow : jasonStatus_FileError);
+        }
+        
+        status = jason_ReadFile(jason, file, (size_t)fileSize);
+        fclose(file);
+#endif
+        
+        return status;
+    }
+    
+    // parse a whole file. Where mmap is available the file is mapped read-only and values point straight
+    // into the mapping, which stays alive until jason_Cleanup or the next jason_DeserializeFile
+    jasonStatus jason_DeserializeFile(jason *jason, const char *path)
+    {
+        if(jason->Free == NULL)
+        {
+            jason->Free = jason_Free;
+        }
+        
+        if(jason->Malloc == NULL)
+        {
+            jason->Malloc = jason_Malloc;
+        }
+        
+        jason_ReleaseFile(jason);
+        jasonStatus status = jason_OpenFile(jason, path, (uint64_t)JASON_SIZE_MAX);
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        status = jason_Deserialize(jason, (const char*)jason->File, (jasonSize)jason->FileSize);
+        if(status != jasonStatus_Finished)
+        {
+            jason_ReleaseFile(jason);
+        }
+        
+        return status;
+    }
+    
+    uint64_t jason_SavedChecksum(uint64_t checksum, const char *chunk, size_t len)
+    {
+        return jason_HashMix(checksum ^ jason_HashSeeded(chunk, len, JASON_SAVED_CHECKSUM_SEED), 0x9E3779B97F4A7C15ull + len);
+    }
+    
+    void jasonSaver_Flush(jasonSaver *saver)
+    {
+        if(saver->Used > 0 && saver->Status == jasonStatus_Continue)
+        {
+            saver->Checksum = jason_SavedChecksum(saver->Checksum, saver->Buffer, saver->Used);
+            if(fwrite(saver->Buffer, 1, saver->Used, saver->File) != saver->Used)
+            {
+                saver->Status = jasonStatus_Break(jasonStatus_FileError);
+            }
+        }
+        
+        saver->Used = 0;
+    }
+    
+    void jasonSaver_Write(jasonSaver *saver, const void *data, size_t len)
+    {
+        const char *it = (const char*)data;
+        saver->Offset += len;
+        
+        while(len > 0)
+        {
+            size_t count = JASON_SAVED_CHUNK - saver->Used;
+            count = (count < len) ? count : len;
+            memcpy(saver->Buffer + saver->Used, it, count);
+            saver->Used += count;
+            it += count;
+            len -= count;
+            
+            if(saver->Used == JASON_SAVED_CHUNK)
+            {
+                jasonSaver_Flush(saver);
+            }
+        }
+    }
+    
+    // pad with zeros to the next section, returns its offset
+    uint64_t jasonSaver_Align(jasonSaver *saver)
+    {
+        static const char zeros[JASON_SAVED_ALIGN];
+        jasonSaver_Write(saver, zeros, (JASON_SAVED_ALIGN - saver->Offset % JASON_SAVED_ALIGN) % JASON_SAVED_ALIGN);
+        return saver->Offset;
+    }
+    
+    // write a parsed document to a file jason_LoadFile maps back without parsing it: the source text the values point into,
+    // the tape with offsets for pointers, the key index and the decoded numbers. Containers expanded by jasonFlag_Lazy
+    // are left out and expanded again after loading. A document fed in more than one source block has no single source
+    // text and cannot be saved
+    jasonStatus jason_SaveFile(jason *jason, const char *path)
+    {
+        if(jason->RootValue == NULL || jason->NumValues == 0)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        if(jason->SourceBlocks != NULL && jason->SourceBlocks->Prev != NULL)
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        // the source saved is the span of text covered by the values
+        const char *begin = jason->RootValue->Value;
+        const char *end = begin;
+        for(jasonSize i = 0; i < jason->NumValues; i++)
+        {
+            jasonValue *value = jason->RootValue + i;
+            jasonValueType type = jasonValue_GetType(value);
+            jasonSize len = value->ValueLen;
+            
+            if(type == jasonValueType_Object || type == jasonValueType_Array)
+            {
+                len = (len < 0) ? -len : 1;
+            }
+            else if(type == jasonValueType_String)
+            {
+                len &= JASON_VALUELEN_MASK;
+            }
+            
+            begin = (value->Value < begin) ? value->Value : begin;
+            end = (value->Value + len > end) ? value->Value + len : end;
+        }
+        
+        jasonSavedHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.Magic, JASON_SAVED_MAGIC, sizeof(header.Magic));
+        header.Version = JASON_SAVED_VERSION;
+        header.ByteOrder = 0x01020304;
+        header.Layout = JASON_SAVED_LAYOUT;
+        header.Flags = jason->Flags;
+        header.HashSeed = jason->HashSeed;
+        header.DefaultHash = (jason->Hash == jason_Hash);
+        header.DirectorySize = jason->KeyLookupTable.DirectorySize;
+        header.NumIndexed = jason->KeyLookupTable.NumIndexed;
+        header.NumValues = (uint64_t)jason->NumValues;
+        
+        jasonSaver saver;
+        memset(&saver, 0, sizeof(saver));
+        size_t memLength = JASON_SAVED_CHUNK;
+        saver.Buffer = jason->Malloc(&memLength);
+        if(saver.Buffer == NULL || memLength < JASON_SAVED_CHUNK)
+        {
+            jason->Free(saver.Buffer);
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        // room for the header, which is written last once the checksum is known
+        memset(saver.Buffer, 0, JASON_SAVED_BODY);
+        saver.File = fopen(path, "wb");
+        if(saver.File == NULL || fwrite(saver.Buffer, 1, JASON_SAVED_BODY, saver.File) != JASON_SAVED_BODY)
+        {
+            saver.Status = jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        saver.Offset = JASON_SAVED_BODY;
+        header.SourceOffset = saver.Offset;
+        header.SourceSize = (uint64_t)(end - begin);
+        jasonSaver_Write(&saver, begin, (size_t)header.SourceSize);
+        
+        header.TapeOffset = jasonSaver_Align(&saver);
+        jasonValue relocated[256];
+        for(jasonSize i = 0; i < jason->NumValues; i += 256)
+        {
+            jasonSize count = (jason->NumValues - i < 256) ? jason->NumValues - i : 256;
+            memcpy(relocated, jason->RootValue + i, count * sizeof(jasonValue));
+            for(jasonSize j = 0; j < count; j++)
+            {
+                relocated[j].Value = (const char*)(uintptr_t)(relocated[j].Value - begin);
+            }
+            
+            jasonSaver_Write(&saver, relocated, count * sizeof(jasonValue));
+        }
+        
+        header.DirectoryOffset = jasonSaver_Align(&saver);
+        jasonSaver_Write(&saver, jason->KeyLookupTable.Directory, (size_t)header.DirectorySize * sizeof(jasonObjectIndex));
+        
+        header.SlotsOffset = jasonSaver_Align(&saver);
+        header.SlotsSize = jason->KeyLookupTable.SlotsUsed;
+        jasonSaver_Write(&saver, jason->KeyLookupTable.Slots, jason->KeyLookupTable.SlotsUsed);
+        
+        if(jason->Numbers != NULL && (jason->Flags & jasonFlag_DecodeNumbers))
+        {
+            header.NumbersOffset = jasonSaver_Align(&saver);
+            jasonSaver_Write(&saver, jason->Numbers, (size_t)jason->NumValues * sizeof(jasonNumber));
+        }
+        
+        jasonSaver_Flush(&saver);
+        header.FileSize = saver.Offset;
+        header.Checksum = saver.Checksum;
+        
+        if(saver.Status == jasonStatus_Continue && (fseek(saver.File, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, saver.File) != 1))
+        {
+            saver.Status = jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        if(saver.File != NULL && fclose(saver.File) != 0 && saver.Status == jasonStatus_Continue)
+        {
+            saver.Status = jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        jason->Free(saver.Buffer);
+        return (saver.Status == jasonStatus_Continue) ? jasonStatus_Finished : saver.Status;
+    }
+    
+    int32_t jason_SavedSectionFits(const jasonSavedHeader *header, uint64_t offset, uint64_t size)
+    {
+        return offset >= JASON_SAVED_BODY && offset % JASON_SAVED_ALIGN == 0 && offset <= header->FileSize && size <= header->FileSize - offset;
+    }
+    
+    // check the saved file in jason->File and take the document from it
+    jasonStatus jason_UseSavedFile(jason *jason)
+    {
+        char *file = (char*)jason->File;
+        const jasonSavedHeader *header = (const jasonSavedHeader*)file;
+        if(jason->FileSize < JASON_SAVED_BODY || memcmp(header->Magic, JASON_SAVED_MAGIC, sizeof(header->Magic)) != 0 || header->Version != JASON_SAVED_VERSION || header->ByteOrder != 0x01020304 || header->Layout != JASON_SAVED_LAYOUT || header->FileSize != jason->FileSize)
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        // catches a damaged file, not one crafted to pass: a file that does is trusted like a tape the parser built
+        uint64_t checksum = 0;
+        for(uint64_t offset = JASON_SAVED_BODY; offset < header->FileSize; offset += JASON_SAVED_CHUNK)
+        {
+            uint64_t remaining = header->FileSize - offset;
+            checksum = jason_SavedChecksum(checksum, file + offset, (size_t)(remaining < JASON_SAVED_CHUNK ? remaining : JASON_SAVED_CHUNK));
+        }
+        
+        // every value takes a byte of the file at least, which keeps the section sizes below from overflowing
+        uint64_t numValues = header->NumValues;
+        int32_t directorySize = header->DirectorySize;
+        if(checksum != header->Checksum || numValues == 0 || numValues > (uint64_t)JASON_SIZE_MAX || numValues > header->FileSize || header->SourceSize >= (uint64_t)JASON_SIZE_MAX)
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        if(directorySize < 0 || (directorySize & (directorySize - 1)) != 0 || header->NumIndexed < 0 || (int64_t)header->NumIndexed * 2 > directorySize)
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        if(!jason_SavedSectionFits(header, header->SourceOffset, header->SourceSize) || !jason_SavedSectionFits(header, header->TapeOffset, numValues * sizeof(jasonValue)) || !jason_SavedSectionFits(header, header->DirectoryOffset, (uint64_t)directorySize * sizeof(jasonObjectIndex)) || !jason_SavedSectionFits(header, header->SlotsOffset, header->SlotsSize) || (header->NumbersOffset != 0 && !jason_SavedSectionFits(header, header->NumbersOffset, numValues * sizeof(jasonNumber))))
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        // numbers are saved exactly when they were decoded, jason_GetNumber reads them by that flag
+        if((header->NumbersOffset != 0) != ((header->Flags & jasonFlag_DecodeNumbers) != 0))
+        {
+            return jasonStatus_Break(jasonStatus_FileError);
+        }
+        
+        jason->Flags = header->Flags;
+        jasonStatus status = jason_ReserveValues(jason, (jasonSize)numValues);
+        if(status == jasonStatus_Continue && jason->MaxValues < (jasonSize)numValues)
+        {
+            status = jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        const char *source = file + header->SourceOffset;
+        const jasonValue *tape = (const jasonValue*)(file + header->TapeOffset);
+        for(uint64_t i = 0; i < numValues; i++)
+        {
+            uintptr_t offset = (uintptr_t)tape[i].Value;
+            if(offset >= header->SourceSize)
+            {
+                return jasonStatus_Break(jasonStatus_FileError);
+            }
+            
+            jason->RootValue[i] = tape[i];
+            jason->RootValue[i].Value = source + offset;
+        }
+        
+        jason->NumValues = (jasonSize)numValues;
+        if(header->NumbersOffset != 0)
+        {
+            memcpy(jason->Numbers, file + header->NumbersOffset, (size_t)numValues * sizeof(jasonNumber));
+        }
+        
+        // the key index as it was built, the directory at the same size so every object keeps its slot
+        jasonHashTable *table = &jason->KeyLookupTable;
+        if(table->DirectorySize != directorySize)
+        {
+            jason->Free(table->Directory);
+            table->Directory = NULL;
+            table->DirectorySize = 0;
+            
+            size_t memLength = (size_t)directorySize * sizeof(jasonObjectIndex);
+            if(directorySize > 0)
+            {
+                table->Directory = jason->Malloc(&memLength);
+                if(table->Directory == NULL || memLength < (size_t)directorySize * sizeof(jasonObjectIndex))
+                {
+                    jason->Free(table->Directory);
+                    table->Directory = NULL;
+                    return jasonStatus_Break(jasonStatus_OutOfMemory);
+                }
+            }
+            
+            table->DirectorySize = directorySize;
+        }
+        
+        status = jason_GrowBuffer(jason, (void**)&table->Slots, &table->SlotsSize, (size_t)header->SlotsSize);
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        if(directorySize > 0)
+        {
+            memcpy(table->Directory, file + header->DirectoryOffset, (size_t)directorySize * sizeof(jasonObjectIndex));
+        }
+        
+        if(header->SlotsSize > 0)
+        {
+            memcpy(table->Slots, file + header->SlotsOffset, (size_t)header->SlotsSize);
+        }
+        
+        table->SlotsUsed = (size_t)header->SlotsSize;
+        table->NumIndexed = header->NumIndexed;
+        
+        // lookups hash with the document's function, so an index built with another one cannot be used. A caller's
+        // function is taken to be the one the file was saved with
+        if((jason->Hash == jason_Hash) != (header->DefaultHash != 0))
+        {
+            table->NumIndexed = 0;
+        }
+        
+        jason->HashSeed = header->HashSeed;
+        jason->ParsePosition = source;
+        jason->ParseState = jasonParseState_Done;
+        return jasonStatus_Continue;
+    }
+    
+    // load a file written by jason_SaveFile, mapped where mmap is available. Nothing is parsed or hashed: the tape is
+    // copied into the document with its offsets turned back into pointers to the file's source text, and the key index
+    // is copied as it was saved. Set Hash first when the file was saved with a function of the caller's. The document
+    // takes the flags it was saved with and the file stays mapped as for jason_DeserializeFile
+    jasonStatus jason_LoadFile(jason *jason, const char *path)
+    {
+        // memory kept from an earlier document is reused as it is by a parse
+        jasonStatus status = jason_Begin(jason);
+        jason_ReleaseFile(jason);
+        
+        if(status == jasonStatus_Continue)
+        {
+            status = jason_OpenFile(jason, path, UINT64_MAX);
+        }
+        
+        if(status == jasonStatus_Continue)
+        {
+            status = jason_UseSavedFile(jason);
+        }
+        
+        if(status != jasonStatus_Continue)
+        {
+            jason_ReleaseFile(jason);
+            jason->NumValues = 0;
+            jason->KeyLookupTable.NumIndexed = 0;
+            return status;
+        }
+        
+        return jasonStatus_Finished;
+    }
+    
+    // bytes a document holds on to through jason_Reset
+    size_t jason_RetainedBytes(jason *jason)
+    {
+        size_t bytes = (size_t)jason->MaxValues * sizeof(jasonValue) + jason->NumbersSize + jason->KeyLookupTable.SlotsSize;
+        bytes += (size_t)jason->KeyLookupTable.DirectorySize * sizeof(jasonObjectIndex);
+        bytes += (size_t)jason->ExpansionsSize * sizeof(jasonExpansion*);
+        
+        if(jason->OwnsStack)
+        {
+            bytes += (size_t)jason->StackSize * sizeof(jasonFrame);
+        }
+        
+        for(jasonSourceBlock *block = jason->SourceBlocks; block != NULL; block = block->Prev)
+        {
+            bytes += block->Size;
+        }
+        
+        return bytes;
+    }
+    
+    // ready the context for its next document. Memory is kept unless the last one left more than MaxRetainedBytes behind
+    void jasonContext_Reset(jasonContext *context)
+    {
+        size_t maxRetained = context->MaxRetainedBytes > 0 ? context->MaxRetainedBytes : JASON_CONTEXT_MAX_RETAINED;
+        
+        if(context->Document.Free != NULL)
+        {
+            jason_ReleaseFile(&context->Document);
+            if(jason_RetainedBytes(&context->Document) > maxRetained)
+            {
+                jason_Cleanup(&context->Document);
+            }
+            else
+            {
+                jason_Reset(&context->Document);
+            }
+        }
+        
+        if(context->Arena.Free != NULL)
+        {
+            jasonArena_Reset(&context->Arena, maxRetained);
+        }
+    }
+    
+    jasonStatus jasonContext_Deserialize(jasonContext *context, const char *json, jasonSize jsonLen)
+    {
+        jasonContext_Reset(context);
+        return jason_Deserialize(&context->Document, json, jsonLen);
+    }
+    
+    // a decoded, null-terminated copy of a string value in the context's arena, good until the context is reset
+    char *jasonContext_CopyString(jasonContext *context, jasonValue *value, jasonSize *length)
+    {
+        if(jasonValue_GetType(value) != jasonValueType_String)
+        {
+            return NULL;
+        }
+        
+        if(context->Arena.Malloc == NULL && context->Document.Malloc != NULL)
+        {
+            context->Arena.Malloc = context->Document.Malloc;
+            context->Arena.Free = context->Document.Free;
+        }
+        
+        jasonSize bufferLen = jasonValue_GetValueLen(value) + 1;
+        char *buffer = jasonArena_Alloc(&context->Arena, (size_t)bufferLen);
+        if(buffer == NULL || jasonValue_UnescapeInto(value, buffer, bufferLen, length) != jasonStatus_Finished)
+        {
+            return NULL;
+        }
+        
+        return buffer;
+    }
+    
+    void jasonContext_Free(jasonContext *context)
+    {
+        if(context->Document.Free != NULL)
+        {
+            jason_Cleanup(&context->Document);
+        }
+        
+        if(context->Arena.Free != NULL)
+        {
+            jasonArena_Free(&context->Arena);
+        }
+    }
+    
+    // contexts released on this thread and waiting to be acquired again. Every thread has its own, so none of it is locked
+    jasonContext **jason_ContextPool(int32_t **numPooled)
+    {
+        static JASON_THREAD_LOCAL jasonContext *pool[JASON_CONTEXT_POOL_SIZE];
+        static JASON_THREAD_LOCAL int32_t poolSize = 0;
+        
+        *numPooled = &poolSize;
+        return pool;
+    }
+    
+    // a context from the calling thread's pool, or a new one when the pool is empty. NULL when out of memory
+    jasonContext *jasonContext_Acquire(void)
+    {
+        int32_t *numPooled = NULL;
+        jasonContext **pool = jason_ContextPool(&numPooled);
+        
+        if(*numPooled > 0)
+        {
+            return pool[--*numPooled];
+        }
+        
+        size_t memLength = sizeof(jasonContext);
+        jasonContext *context = jason_Malloc(&memLength);
+        if(context != NULL)
+        {
+            memset(context, 0, sizeof(jasonContext));
+        }
+        
+        return context;
+    }
+    
+    // reset the context into the calling thread's pool, it is freed when the pool is full. It may come from another thread
+    void jasonContext_Release(jasonContext *context)
+    {
+        int32_t *numPooled = NULL;
+        jasonContext **pool = jason_ContextPool(&numPooled);
+        
+        jasonContext_Reset(context);
+        if(*numPooled < JASON_CONTEXT_POOL_SIZE)
+        {
+            pool[(*numPooled)++] = context;
+            return;
+        }
+        
+        jasonContext_Free(context);
+        jason_Free(context);
+    }
+    
+    // free the calling thread's pooled contexts, before the thread exits
+    void jasonContext_FreePool(void)
+    {
+        int32_t *numPooled = NULL;
+        jasonContext **pool = jason_ContextPool(&numPooled);
+        
+        while(*numPooled > 0)
+        {
+            jasonContext *context = pool[--*numPooled];
+            jasonContext_Free(context);
+            jason_Free(context);
+        }
+    }
+    
+    jasonStatus jasonWriter_Fail(jasonWriter *writer, jasonStatus status)
+    {
+        if(writer->Status == jasonStatus_Continue)
+        {
+            writer->Status = status;
+        }
+        
+        return writer->Status;
+    }
+    
+    jasonStatus jasonWriter_Grow(jasonWriter *writer, size_t needed)
+    {
+        if(writer->Malloc == NULL)
+        {
+            writer->Malloc = jason_Malloc;
+            writer->Free = jason_Free;
+            writer->Realloc = jason_Realloc;
+        }
+        
+        size_t memLength = writer->Size > 0 ? writer->Size : 256;
+        while(memLength < needed)
+        {
+            if(memLength > SIZE_MAX / 2)
+            {
+                return jasonWriter_Fail(writer, jasonStatus_Break(jasonStatus_OutOfMemory));
+            }
+            
+            memLength *= 2;
+        }
+        
+        char *newBuffer = NULL;
+        if(writer->Buffer != NULL && writer->Realloc != NULL)
+        {
+            newBuffer = writer->Realloc(writer->Buffer, &memLength);
+        }
+        else
+        {
+            newBuffer = writer->Malloc(&memLength);
+            if(newBuffer != NULL && writer->Buffer != NULL)
+            {
+                memcpy(newBuffer, writer->Buffer, writer->Used);
+                writer->Free(writer->Buffer);
+            }
+        }
+        
+        if(newBuffer == NULL || memLength < needed)
+        {
+            return jasonWriter_Fail(writer, jasonStatus_Break(jasonStatus_OutOfMemory));
+        }
+        
+        writer->Buffer = newBuffer;
+        writer->Size = memLength;
+        return jasonStatus_Continue;
+    }
+    
+    jasonStatus jasonWriter_Write(jasonWriter *writer, const char *data, size_t len)
+    {
+        if(writer->IoVecs != NULL)
+        {
+            while(len > 0)
+            {
+                if(writer->IoVecIndex >= writer->NumIoVecs)
+                {
+                    return jasonWriter_Fail(writer, jasonStatus_Break(jasonStatus_OutOfMemory));
+                }
+                
+                jasonIoVec *vec = writer->IoVecs + writer->IoVecIndex;
+                size_t room = vec->Len - writer->IoVecUsed;
+                size_t bytes = len < room ? len : room;
+                
+                memcpy(vec->Base + writer->IoVecUsed, data, bytes);
+                writer->IoVecUsed += bytes;
+                data += bytes;
+                len -= bytes;
+                
+                if(writer->IoVecUsed == vec->Len)
+                {
+                    writer->IoVecIndex++;
+                    writer->IoVecUsed = 0;
+                }
+            }
+            
+            return jasonStatus_Continue;
+        }
+        
+        if(writer->Size - writer->Used < len && jasonWriter_Grow(writer, writer->Used + len) != jasonStatus_Continue)
+        {
+            return writer->Status;
+        }
+        
+        memcpy(writer->Buffer + writer->Used, data, len);
+        writer->Used += len;
+        return jasonStatus_Continue;
+    }
+    
+    jasonStatus jasonWriter_NewLine(jasonWriter *writer)
+    {
+        static const char spaces[] = "                                ";
+        size_t indent = (size_t)writer->Depth * (size_t)(writer->Indent > 0 ? writer->Indent : JASON_DEFAULT_INDENT);
+        jasonStatus status = jasonWriter_Write(writer, "\n", 1);
+        
+        while(indent > 0 && status == jasonStatus_Continue)
+        {
+            size_t bytes = indent < sizeof(spaces) - 1 ? indent : sizeof(spaces) - 1;
+            status = jasonWriter_Write(writer, spaces, bytes);
+            indent -= bytes;
+        }
+        
+        return status;
+    }
+    
+    // separator and indentation before a key or a value
+    jasonStatus jasonWriter_Separate(jasonWriter *writer)
+    {
+        if(writer->Status != jasonStatus_Continue)
+        {
+            return writer->Status;
+        }
+        
+        if(writer->AfterKey)
+        {
+            writer->AfterKey = 0;
+            return jasonStatus_Continue;
+        }
+        
+        jasonStatus status = jasonStatus_Continue;
+        if(writer->Depth > 0)
+        {
+            if(!writer->First)
+            {
+                status = jasonWriter_Write(writer, ",", 1);
+            }
+            
+            if(status == jasonStatus_Continue && (writer->Flags & jasonWriterFlag_Pretty))
+            {
+                status = jasonWriter_NewLine(writer);
+            }
+        }
+        
+        writer->First = 0;
+        return status;
+    }
+    
+    jasonStatus jasonWriter_Open(jasonWriter *writer, const char *bracket)
+    {
+        jasonStatus status = jasonWriter_Separate(writer);
+        if(status == jasonStatus_Continue)
+        {
+            status = jasonWriter_Write(writer, bracket, 1);
+        }
+        
+        writer->Depth++;
+        writer->First = 1;
+        return status;
+    }
+    
+    jasonStatus jasonWriter_Close(jasonWriter *writer, const char *bracket)
+    {
+        if(writer->Status != jasonStatus_Continue)
+        {
+            return writer->Status;
+        }
+        
+        if(writer->Depth == 0)
+        {
+            return jasonWriter_Fail(writer, jasonStatus_Break(jasonStatus_UnexpectedCharacter));
+        }
+        
+        writer->Depth--;
+        jasonStatus status = jasonStatus_Continue;
+        if(!writer->First && (writer->Flags & jasonWriterFlag_Pretty))
+        {
+            status = jasonWriter_NewLine(writer);
+        }
+        
+        writer->First = 0;
+        return (status == jasonStatus_Continue) ? jasonWriter_Write(writer, bracket, 1) : status;
+    }
+    
+    jasonStatus jasonWriter_BeginObject(jasonWriter *writer)
+    {
+        return jasonWriter_Open(writer, "{");
+    }
+    
+    jasonStatus jasonWriter_EndObject(jasonWriter *writer)
+    {
+        return jasonWriter_Close(writer, "}");
+    }
+    
+    jasonStatus jasonWriter_BeginArray(jasonWriter *writer)
+    {
+        return jasonWriter_Open(writer, "[");
+    }
+    
+    jasonStatus jasonWriter_EndArray(jasonWriter *writer)
+    {
+        return jasonWriter_Close(writer, "]");
+    }
+    
+    // quoted and escaped, runs that need no escaping are found 16 bytes at a time and copied whole
+    jasonStatus jasonWriter_Quote(jasonWriter *writer, const char *str, size_t len)
+    {
+        static const char hex[] = "0123456789abcdef";
+        const char *end = str + len;
+        const char *run = str;
+        const char *it = str;
+        jasonStatus status = jasonWriter_Write(writer, "\"", 1);
+        
+        while(it < end && status == jasonStatus_Continue)
+        {
+#if defined(JASON_X86_SIMD) && defined(__SSE2__)
+            while(end - it >= 16)
+            {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)it);
+                __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+                special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(0x1F)), chunk));
+                
+                uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+                if(mask != 0)
+                {
+                    it += jason_CountTrailingZeros(mask);
+                    break;
+                }
+                
+                it += 16;
+            }
+#endif
+            while(it < end && *it != '"' && *it != '\\' && (unsigned char)*it >= 0x20)
+            {
+                it++;
+            }
+            
+            if(it >= end)
+            {
+                break;
+            }
+            
+            status = jasonWriter_Write(writer, run, it - run);
+            
+            char escape[6] = { '\\', 0, '0', '0', 0, 0 };
+            size_t escapeLen = 2;
+            switch(*it)
+            {
+                case '"':
+                    escape[1] = '"';
+                    break;
+                    
+                case '\\':
+                    escape[1] = '\\';
+                    break;
+                    
+                case '\b':
+                    escape[1] = 'b';
+                    break;
+                    
+                case '\f':
+                    escape[1] = 'f';
+                    break;
+                    
+                case '\n':
+                    escape[1] = 'n';
+                    break;
+                    
+                case '\r':
+                    escape[1] = 'r';
+                    break;
+                    
+                case '\t':
+                    escape[1] = 't';
+                    break;
+                    
+                default:
+                    escape[1] = 'u';
+                    escape[4] = hex[(unsigned char)*it >> 4];
+                    escape[5] = hex[(unsigned char)*it & 0xF];
+                    escapeLen = 6;
+                    break;
+            }
+            
+            if(status == jasonStatus_Continue)
+            {
+                status = jasonWriter_Write(writer, escape, escapeLen);
+            }
+            
+            run = ++it;
+        }
+        
+        if(status == jasonStatus_Continue)
+        {
+            status = jasonWriter_Write(writer, run, end - run);
+        }
+        
+        return (status == jasonStatus_Continue) ? jasonWriter_Write(writer, "\"", 1) : status;
+    }
+    
+    jasonStatus jasonWriter_Key(jasonWriter *writer, const char *key, size_t keyLen)
+    {
+        jasonStatus status = jasonWriter_Separate(writer);
+        if(status == jasonStatus_Continue)
+        {
+            status = jasonWriter_Quote(writer, key, keyLen);
+        }
+        
+        if(status == jasonStatus_Continue)
+        {
+            status = jasonWriter_Write(writer, ": ", (writer->Flags & jasonWriterFlag_Pretty) ? 2 : 1);
+        }
+        
+        writer->AfterKey = 1;
+        return status;
+    }
+    
+    jasonStatus jasonWriter_String(jasonWriter *writer, const char *str, size_t len)
+    {
+        jasonStatus status = jasonWriter_Separate(writer);
+        return (status == jasonStatus_Continue) ? jasonWriter_Quote(writer, str, len) : status;
+    }
+    
+    // already valid JSON text, written as it is
+    jasonStatus jasonWriter_Raw(jasonWriter *writer, const char *text, size_t len)
+    {
+        jasonStatus status = jasonWriter_Separate(writer);
+        return (status == jasonStatus_Continue) ? jasonWriter_Write(writer, text, len) : status;
+    }
+    
+    // digits written backwards from 'end', returns the first one
+    char *jason_FormatUint64(char *end, uint64_t value)
+    {
+        static const char pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        
+        char *it = end;
+        while(value >= 100)
+        {
+            const char *pair = pairs + (value % 100) * 2;
+            value /= 100;
+            *--it = pair[1];
+            *--it = pair[0];
+        }
+        
+        if(value >= 10)
+        {
+            *--it = pairs[value * 2 + 1];
+            *--it = pairs[value * 2];
+        }
+        else
+        {
+            *--it = (char)('0' + value);
+        }
+        
+        return it;
+    }
+    
+    jasonStatus jasonWriter_Uint64(jasonWriter *writer, uint64_t value)
+    {
+        char buffer[24];
+        char *digits = jason_FormatUint64(buffer + sizeof(buffer), value);
+        return jasonWriter_Raw(writer, digits, buffer + sizeof(buffer) - digits);
+    }
+    
+    jasonStatus jasonWriter_Int64(jasonWriter *writer, int64_t value)
+    {
+        char buffer[24];
+        char *digits = jason_FormatUint64(buffer + sizeof(buffer), value < 0 ? 0 - (uint64_t)value : (uint64_t)value);
+        if(value < 0)
+        {
+            *--digits = '-';
+        }
+        
+        return jasonWriter_Raw(writer, digits, buffer + sizeof(buffer) - digits);
+    }
+    
+    // the 128-bit power times cp, keeping the high word with any bits below it folded into its lowest bit
+    uint64_t jason_RoundToOdd(const uint64_t *power, uint64_t cp)
+    {
+        uint64_t lowLow, highLow;
+        uint64_t lowHigh = jason_Multiply128(power[1], cp, &lowLow);
+        uint64_t high = jason_Multiply128(power[0], cp, &highLow);
+        uint64_t middle = highLow + lowHigh;
+        high += (middle < highLow);
+        return high | (middle > 1);
+    }
+    
+    // Schubfach: the decimal with the fewest digits that reads back as the finite, non-zero double 'bits', the
+    // nearest one when there are several. Returns the digits, which may end in zeros, and sets their power of ten
+    uint64_t jason_ShortestDecimal(uint64_t bits, int32_t *exponent)
+    {
+        uint64_t fraction = bits & (((uint64_t)1 << 52) - 1);
+        int32_t biased = (int32_t)((bits >> 52) & 0x7FF);
+        uint64_t c = (biased != 0) ? (fraction | ((uint64_t)1 << 52)) : fraction;
+        int32_t q = (biased != 0) ? biased - 1075 : -1074;
+        
+        if(q <= 0 && q >= -52 && (c & (((uint64_t)1 << -q) - 1)) == 0)
+        {
+            *exponent = 0;
+            return c >> -q;
+        }
+        
+        // at a power of two the gap to the double below is half the one above. Odd doubles lose ties when read
+        // back, so their bounds are excluded
+        uint64_t closerBelow = (fraction == 0 && biased > 1);
+        uint64_t odd = c & 1;
+        int32_t k = closerBelow ? ((q * 1262611 - 524031) >> 22) : ((q * 1262611) >> 22);
+        int32_t h = q + ((-k * 1741647) >> 19) + 1;
+        
+        // 10^-k rounded up, the table is truncated and only exact from 5^0 to 5^55
+        int index = 2 * (342 - k);
+        uint64_t power[2] = { jason_PowersOfFive[index], jason_PowersOfFive[index + 1] };
+        if(k > 0 || k < -55)
+        {
+            power[1]++;
+            power[0] += (power[1] == 0);
+        }
+        
+        uint64_t below = jason_RoundToOdd(power, (4 * c - 2 + closerBelow) << h) + odd;
+        uint64_t middle = jason_RoundToOdd(power, (4 * c) << h);
+        uint64_t above = jason_RoundToOdd(power, (4 * c + 2) << h) - odd;
+        
+        uint64_t s = middle >> 2;
+        if(s >= 10)
+        {
+            // one digit fewer, if exactly one of its two neighbours reads back
+            uint64_t shorter = s / 10;
+            int32_t downInside = (below <= 40 * shorter);
+            int32_t upInside = (40 * shorter + 40 <= above);
+            if(downInside != upInside)
+            {
+                *exponent = k + 1;
+                return shorter + upInside;
+            }
+        }
+        
+        *exponent = k;
+        int32_t downInside = (below <= 4 * s);
+        int32_t upInside = (4 * s + 4 <= above);
+        if(downInside != upInside)
+        {
+            return s + upInside;
+        }
+        
+        return s + (middle > 4 * s + 2 || (middle == 4 * s + 2 && (s & 1) != 0));
+    }
+    
+    // the shortest text that reads back as the same double, laid out as JavaScript does but without a + in
+    // positive exponents. JSON has no infinities or NaN, they are written as null
+    jasonStatus jasonWriter_Double(jasonWriter *writer, double value)
+    {
+        if(value != value || value - value != 0)
+        {
+            return jasonWriter_Raw(writer, "null", 4);
+        }
+        
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        
+        char buffer[40];
+        char *it = buffer;
+        if(bits >> 63)
+        {
+            *it++ = '-';
+        }
+        
+        if((bits << 1) == 0)
+        {
+            *it++ = '0';
+            return jasonWriter_Raw(writer, buffer, it - buffer);
+        }
+        
+        int32_t exponent;
+        uint64_t decimal = jason_ShortestDecimal(bits, &exponent);
+        while(decimal % 10 == 0)
+        {
+            decimal /= 10;
+            exponent++;
+        }
+        
+        char digits[24];
+        char *first = jason_FormatUint64(digits + sizeof(digits), decimal);
+        int32_t count = (int32_t)(digits + sizeof(digits) - first);
+        int32_t point = count + exponent;
+        
+        if(exponent >= 0 && point <= 21)
+        {
+            memcpy(it, first, count);
+            memset(it + count, '0', exponent);
+            it += point;
+        }
+        else if(point > 0 && point <= 21)
+        {
+            memcpy(it, first, point);
+            it[point] = '.';
+            memcpy(it + point + 1, first + point, count - point);
+            it += count + 1;
+        }
+        else if(point > -6 && point <= 0)
+        {
+            *it++ = '0';
+            *it++ = '.';
+            memset(it, '0', -point);
+            memcpy(it - point, first, count);
+            it += count - point;
+        }
+        else
+        {
+            *it++ = first[0];
+            if(count > 1)
+            {
+                *it++ = '.';
+                memcpy(it, first + 1, count - 1);
+                it += count - 1;
+            }
+            
+            *it++ = 'e';
+            int32_t power = point - 1;
+            if(power < 0)
+            {
+                *it++ = '-';
+                power = -power;
+            }
+            
+            char *powerDigits = jason_FormatUint64(digits + sizeof(digits), (uint64_t)power);
+            memcpy(it, powerDigits, digits + sizeof(digits) - powerDigits);
+            it += digits + sizeof(digits) - powerDigits;
+        }
+        
+        return jasonWriter_Raw(writer, buffer, it - buffer);
+    }
+    
+    jasonStatus jasonWriter_Bool(jasonWriter *writer, int32_t value)
+    {
+        return value ? jasonWriter_Raw(writer, "true", 4) : jasonWriter_Raw(writer, "false", 5);
+    }
+    
+    jasonStatus jasonWriter_Null(jasonWriter *writer)
+    {
+        return jasonWriter_Raw(writer, "null", 4);
+    }
+    
+    // write a parsed value and everything under it. The tape is already in document order and the
+    // scalars are already valid JSON text, so this is a single pass of copies
+    jasonStatus jasonWriter_WriteValue(jasonWriter *writer, jasonValue *value)
+    {
+        int32_t base = writer->Depth;
+        int32_t depth = 0;
+        
+        for(jasonValue *it = value; writer->Status == jasonStatus_Continue; it++)
+        {
+            jasonWriterFrame *frame = (depth > 0) ? writer->Stack + (depth - 1) : NULL;
+            jasonValueType type = jasonValue_GetType(it);
+            
+            if(frame != NULL && frame->IsObject && frame->NextIsKey)
+            {
+                if(jasonWriter_Separate(writer) == jasonStatus_Continue && jasonWriter_Write(writer, it->Value, it->ValueLen & JASON_VALUELEN_MASK) == jasonStatus_Continue)
+                {
+                    jasonWriter_Write(writer, ": ", (writer->Flags & jasonWriterFlag_Pretty) ? 2 : 1);
+                }
+                
+                writer->AfterKey = 1;
+                frame->NextIsKey = 0;
+                frame->Remaining--;
+                continue;
+            }
+            
+            if((type == jasonValueType_Object || type == jasonValueType_Array) && it->ValueLen > 0)
+            {
+                if(depth >= writer->StackSize)
+                {
+                    int32_t newStackSize = writer->StackSize > 0 ? writer->StackSize * 2 : 16;
+                    size_t memLength = newStackSize * sizeof(jasonWriterFrame);
+                    
+                    if(writer->Malloc == NULL)
+                    {
+                        writer->Malloc = jason_Malloc;
+                        writer->Free = jason_Free;
+                        writer->Realloc = jason_Realloc;
+                    }
+                    
+                    jasonWriterFrame *newStack = writer->Malloc(&memLength);
+                    if(newStack == NULL || memLength < newStackSize * sizeof(jasonWriterFrame))
+                    {
+                        writer->Free(newStack);
+                        return jasonWriter_Fail(writer, jasonStatus_Break(jasonStatus_OutOfMemory));
+                    }
+                    
+                    if(writer->Stack != NULL)
+                    {
+                        memcpy(newStack, writer->Stack, depth * sizeof(jasonWriterFrame));
+                        writer->Free(writer->Stack);
+                    }
+                    
+                    writer->Stack = newStack;
+                    writer->StackSize = newStackSize;
+                }
+                
+                jasonWriter_Open(writer, it->Value);
+                frame = writer->Stack + depth++;
+                frame->Remaining = it->ValueLen;
+                frame->IsObject = (type == jasonValueType_Object);
+                frame->NextIsKey = frame->IsObject;
+                continue;
+            }
+            
+            if((type == jasonValueType_Object || type == jasonValueType_Array) && it->ValueLen < 0)
+            {
+                // skipped by jasonFlag_Lazy, copied as it is in the source
+                jasonWriter_Raw(writer, it->Value, (size_t)-it->ValueLen);
+            }
+            else if(type == jasonValueType_Object || type == jasonValueType_Array)
+            {
+                jasonWriter_Open(writer, it->Value);
+                jasonWriter_Close(writer, (type == jasonValueType_Object) ? "}" : "]");
+            }
+            else
+            {
+                jasonWriter_Raw(writer, it->Value, it->ValueLen & JASON_VALUELEN_MASK);
+            }
+            
+            // close every container this value was the last child of
+            while(depth > 0)
+            {
+                frame = writer->Stack + (depth - 1);
+                frame->NextIsKey = frame->IsObject;
+                if(--frame->Remaining > 0)
+                {
+                    break;
+                }
+                
+                jasonWriter_Close(writer, frame->IsObject ? "}" : "]");
+                depth--;
+            }
+            
+            if(depth == 0)
+            {
+                break;
+            }
+        }
+        
+        return (writer->Status == jasonStatus_Continue && writer->Depth == base) ? jasonStatus_Continue : writer->Status;
+    }
+    
+    // trim the caller's buffers to what was written, returns jasonStatus_Finished once every container is closed
+    jasonStatus jasonWriter_Finish(jasonWriter *writer)
+    {
+        if(writer->Status != jasonStatus_Continue)
+        {
+            return writer->Status;
+        }
+        
+        if(writer->IoVecs != NULL)
+        {
+            if(writer->IoVecIndex < writer->NumIoVecs)
+            {
+                writer->IoVecs[writer->IoVecIndex].Len = writer->IoVecUsed;
+                writer->NumIoVecs = writer->IoVecIndex + (writer->IoVecUsed > 0);
+            }
+            else
+            {
+                writer->NumIoVecs = writer->IoVecIndex;
+            }
+        }
+        
+        return (writer->Depth == 0) ? jasonStatus_Finished : jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+    }
+    
+    // start over, keeping the buffer and stack
+    void jasonWriter_Reset(jasonWriter *writer)
+    {
+        writer->Used = 0;
+        writer->IoVecIndex = 0;
+        writer->IoVecUsed = 0;
+        writer->Depth = 0;
+        writer->First = 0;
+        writer->AfterKey = 0;
+        writer->Status = jasonStatus_Continue;
+    }
+    
+    void jasonWriter_Free(jasonWriter *writer)
+    {
+        if(writer->Free != NULL)
+        {
+            writer->Free(writer->Buffer);
+            writer->Free(writer->Stack);
+        }
+        
+        writer->Buffer = NULL;
+        writer->Size = 0;
+        writer->Stack = NULL;
+        writer->StackSize = 0;
+        jasonWriter_Reset(writer);
+    }
+    
+    jasonStatus jason_Serialize(jason *jason, jasonWriter *writer)
+    {
+        if(jason->RootValue == NULL || jason->NumValues == 0)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        jasonStatus status = jasonWriter_WriteValue(writer, jason->RootValue);
+        return (status == jasonStatus_Continue) ? jasonWriter_Finish(writer) : status;
+    }
+    
+    jasonValueType jasonNode_GetType(jasonNode *node)
+    {
+        return jasonValue_GetType(&node->Value);
+    }
+    
+    // the element at index, walking from whichever end is closer. NULL past the end
+    jasonNode *jasonNode_At(jasonNode *array, jasonSize index)
+    {
+        if(index < 0 || index >= array->NumChildren)
+        {
+            return NULL;
+        }
+        
+        jasonNode *node = NULL;
+        if(index < array->NumChildren / 2)
+        {
+            for(node = array->First; index > 0; index--)
+            {
+                node = node->Next;
+            }
+        }
+        else
+        {
+            for(node = array->Last, index = array->NumChildren - 1 - index; index > 0; index--)
+            {
+                node = node->Prev;
+            }
+        }
+        
+        return node;
+    }
+    
+    jasonNode *jason_NewNode(jasonDocument *document, const char *text, jasonSize valueLen)
+    {
+        jasonNode *node = jasonArena_Alloc(&document->Arena, sizeof(jasonNode));
+        if(node != NULL)
+        {
+            memset(node, 0, sizeof(jasonNode));
+            node->Value.Value = text;
+            node->Value.ValueLen = valueLen;
+        }
+        
+        return node;
+    }
+    
+    // a copy of text in the arena, for a node to point at
+    jasonStatus jason_CopyNodeText(jasonDocument *document, const char *text, jasonSize valueLen, jasonValue *value)
+    {
+        jasonSize len = valueLen & JASON_VALUELEN_MASK;
+        char *copy = jasonArena_Alloc(&document->Arena, (size_t)len);
+        if(copy == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        memcpy(copy, text, len);
+        value->Value = copy;
+        value->ValueLen = valueLen;
+        value->Next = 0;
+        return jasonStatus_Continue;
+    }
+    
+    // bytes a string takes once jasonWriter_Quote has quoted and escaped it
+    size_t jason_QuotedLength(const char *str, size_t len)
+    {
+        size_t quotedLen = len + 2;
+        for(size_t i = 0; i < len; i++)
+        {
+            unsigned char c = (unsigned char)str[i];
+            if(c == '"' || c == '\\' || c == '\b' || c == '\f' || c == '\n' || c == '\r' || c == '\t')
+            {
+                quotedLen += 1;
+            }
+            else if(c < 0x20)
+            {
+                quotedLen += 5;
+            }
+        }
+        
+        return quotedLen;
+    }
+    
+    // str quoted and escaped into the arena as a tape string
+    jasonStatus jason_QuoteNodeText(jasonDocument *document, const char *str, size_t len, jasonValue *value)
+    {
+        size_t quotedLen = jason_QuotedLength(str, len);
+        if(quotedLen > (size_t)JASON_VALUELEN_MASK)
+        {
+            return jasonStatus_Break(jasonStatus_IntegerOverflow);
+        }
+        
+        char *text = jasonArena_Alloc(&document->Arena, quotedLen);
+        if(text == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        jasonIoVec vec = { text, quotedLen };
+        jasonWriter writer;
+        memset(&writer, 0, sizeof(jasonWriter));
+        writer.IoVecs = &vec;
+        writer.NumIoVecs = 1;
+        jasonWriter_Quote(&writer, str, len);
+        
+        value->Value = text;
+        value->ValueLen = (jasonSize)quotedLen | (quotedLen > len + 2 ? JASON_STRING_ESCAPED : 0);
+        value->Next = 0;
+        return jasonStatus_Continue;
+    }
+    
+    uint32_t jason_HashNodeKey(jasonDocument *document, const char *key, jasonSize keyLen)
+    {
+        if(document->Hash == NULL)
+        {
+            document->Hash = jason_Hash;
+        }
+        
+        return document->Hash((char*)key, (size_t)keyLen);
+    }
+    
+    // keys are compared as they are written in the JSON text, like jason_HashLookup does
+    int32_t jason_NodeKeyEquals(jasonNode *member, const char *key, jasonSize keyLen)
+    {
+        return (member->Key.ValueLen & JASON_VALUELEN_MASK) - 2 == keyLen && memcmp(member->Key.Value + 1, key, keyLen) == 0;
+    }
+    
+    void jason_IndexNodeSlot(jasonNode *object, jasonNode *member)
+    {
+        uint32_t mask = (uint32_t)object->IndexSize - 1;
+        uint32_t slot = member->KeyHash & mask;
+        
+        // the object itself marks the slot of a removed member
+        while(object->Index[slot] != NULL && object->Index[slot] != object)
+        {
+            slot = (slot + 1) & mask;
+        }
+        
+        object->IndexUsed += (object->Index[slot] == NULL);
+        object->Index[slot] = member;
+    }
+    
+    // add a member to its object's index, building the index once the object has more than JASON_LINEAR_SCAN_KEYS members.
+    // Outgrown indexes are left in the arena
+    jasonStatus jason_IndexNode(jasonDocument *document, jasonNode *object, jasonNode *member)
+    {
+        if(object->Index == NULL && object->NumChildren <= JASON_LINEAR_SCAN_KEYS)
+        {
+            return jasonStatus_Continue;
+        }
+        
+        if(object->Index != NULL && (object->IndexUsed + 1) * 4 <= object->IndexSize * 3)
+        {
+            jason_IndexNodeSlot(object, member);
+            return jasonStatus_Continue;
+        }
+        
+        int32_t indexSize = 16;
+        while(indexSize < object->NumChildren * 2)
+        {
+            if(indexSize > INT32_MAX / 2)
+            {
+                return jasonStatus_Break(jasonStatus_IntegerOverflow);
+            }
+            
+            indexSize *= 2;
+        }
+        
+        jasonNode **index = jasonArena_Alloc(&document->Arena, indexSize * sizeof(jasonNode*));
+        if(index == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        memset(index, 0, indexSize * sizeof(jasonNode*));
+        object->Index = index;
+        object->IndexSize = indexSize;
+        object->IndexUsed = 0;
+        
+        // the new member is already linked in
+        for(jasonNode *it = object->First; it != NULL; it = it->Next)
+        {
+            jason_IndexNodeSlot(object, it);
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    // put member into container before 'before', or last when that is NULL
+    jasonStatus jason_LinkNode(jasonDocument *document, jasonNode *container, jasonNode *before, jasonNode *member)
+    {
+        member->Parent = container;
+        member->Next = before;
+        member->Prev = (before != NULL) ? before->Prev : container->Last;
+        
+        if(member->Prev != NULL)
+        {
+            member->Prev->Next = member;
+        }
+        else
+        {
+            container->First = member;
+        }
+        
+        if(before != NULL)
+        {
+            before->Prev = member;
+        }
+        else
+        {
+            container->Last = member;
+        }
+        
+        container->NumChildren++;
+        return (*container->Value.Value == '{') ? jason_IndexNode(document, container, member) : jasonStatus_Continue;
+    }
+    
+    void jason_UnlinkNode(jasonNode *member)
+    {
+        jasonNode *container = member->Parent;
+        
+        if(container->Index != NULL)
+        {
+            uint32_t mask = (uint32_t)container->IndexSize - 1;
+            uint32_t slot = member->KeyHash & mask;
+            while(container->Index[slot] != member)
+            {
+                slot = (slot + 1) & mask;
+            }
+            
+            container->Index[slot] = container;
+        }
+        
+        if(member->Prev != NULL)
+        {
+            member->Prev->Next = member->Next;
+        }
+        else
+        {
+            container->First = member->Next;
+        }
+        
+        if(member->Next != NULL)
+        {
+            member->Next->Prev = member->Prev;
+        }
+        else
+        {
+            container->Last = member->Prev;
+        }
+        
+        container->NumChildren--;
+        member->Parent = NULL;
+        member->Prev = NULL;
+        member->Next = NULL;
+    }
+    
+    // a node can go into a container when it is not in one already and the container is not inside it
+    int32_t jason_CanLink(jasonNode *container, jasonValueType type, jasonNode *node)
+    {
+        if(jasonNode_GetType(container) != type || node == NULL || node->Parent != NULL)
+        {
+            return 0;
+        }
+        
+        for(jasonNode *it = container; it != NULL; it = it->Parent)
+        {
+            if(it == node)
+            {
+                return 0;
+            }
+        }
+        
+        return 1;
+    }
+    
+    jasonNode *jasonDocument_NewObject(jasonDocument *document)
+    {
+        return jason_NewNode(document, "{", 0);
+    }
+    
+    jasonNode *jasonDocument_NewArray(jasonDocument *document)
+    {
+        return jason_NewNode(document, "[", 0);
+    }
+    
+    // str is plain UTF-8, escaped as it is copied in
+    jasonNode *jasonDocument_NewString(jasonDocument *document, const char *str, size_t len)
+    {
+        jasonNode *node = jason_NewNode(document, NULL, 0);
+        if(node != NULL && jason_QuoteNodeText(document, str, len, &node->Value) != jasonStatus_Continue)
+        {
+            return NULL;
+        }
+        
+        return node;
+    }
+    
+    jasonNode *jasonDocument_NewInt64(jasonDocument *document, int64_t value)
+    {
+        char buffer[24];
+        char *digits = jason_FormatUint64(buffer + sizeof(buffer), value < 0 ? 0 - (uint64_t)value : (uint64_t)value);
+        if(value < 0)
+        {
+            *--digits = '-';
+        }
+        
+        jasonNode *node = jason_NewNode(document, NULL, 0);
+        if(node != NULL && jason_CopyNodeText(document, digits, (jasonSize)(buffer + sizeof(buffer) - digits), &node->Value) != jasonStatus_Continue)
+        {
+            return NULL;
+        }
+        
+        return node;
+    }
+    
+    // NaN and the infinities become null, as with jasonWriter_Double
+    jasonNode *jasonDocument_NewDouble(jasonDocument *document, double value)
+    {
+        char buffer[32];
+        jasonIoVec vec = { buffer, sizeof(buffer) };
+        jasonWriter writer;
+        memset(&writer, 0, sizeof(jasonWriter));
+        writer.IoVecs = &vec;
+        writer.NumIoVecs = 1;
+        jasonWriter_Double(&writer, value);
+        jasonWriter_Finish(&writer);
+        
+        jasonNode *node = jason_NewNode(document, NULL, 0);
+        if(node != NULL && jason_CopyNodeText(document, buffer, (jasonSize)(writer.NumIoVecs > 0 ? vec.Len : 0), &node->Value) != jasonStatus_Continue)
+        {
+            return NULL;
+        }
+        
+        return node;
+    }
+    
+    jasonNode *jasonDocument_NewBool(jasonDocument *document, int32_t value)
+    {
+        return value ? jason_NewNode(document, "true", 4) : jason_NewNode(document, "false", 5);
+    }
+    
+    jasonNode *jasonDocument_NewNull(jasonDocument *document)
+    {
+        return jason_NewNode(document, "null", 4);
+    }
+    
+    // the object's member under key, given as it is written between the quotes in JSON text, so with its escapes
+    jasonNode *jasonDocument_Get(jasonDocument *document, jasonNode *object, const char *key, jasonSize keyLen)
+    {
+        if(jasonNode_GetType(object) != jasonValueType_Object)
+        {
+            return NULL;
+        }
+        
+        if(object->Index == NULL)
+        {
+            for(jasonNode *member = object->First; member != NULL; member = member->Next)
+            {
+                if(jason_NodeKeyEquals(member, key, keyLen))
+                {
+                    return member;
+                }
+            }
+            
+            return NULL;
+        }
+        
+        uint32_t hash = jason_HashNodeKey(document, key, keyLen);
+        uint32_t mask = (uint32_t)object->IndexSize - 1;
+        
+        for(uint32_t slot = hash & mask; object->Index[slot] != NULL; slot = (slot + 1) & mask)
+        {
+            jasonNode *member = object->Index[slot];
+            if(member != object && member->KeyHash == hash && jason_NodeKeyEquals(member, key, keyLen))
+            {
+                return member;
+            }
+        }
+        
+        return NULL;
+    }
+    
+    // give the object's member under key the new value, in place of the current one or appended. key is plain UTF-8,
+    // it is escaped before looking for the member
+    jasonStatus jasonDocument_Set(jasonDocument *document, jasonNode *object, const char *key, jasonSize keyLen, jasonNode *value)
+    {
+        if(!jason_CanLink(object, jasonValueType_Object, value))
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        // a key with nothing to escape is looked up as it is and only copied when it is new
+        jasonValue quoted;
+        quoted.Value = NULL;
+        if(jason_QuotedLength(key, (size_t)keyLen) > (size_t)keyLen + 2)
+        {
+            jasonStatus status = jason_QuoteNodeText(document, key, (size_t)keyLen, &quoted);
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+            
+            key = quoted.Value + 1;
+            keyLen = (quoted.ValueLen & JASON_VALUELEN_MASK) - 2;
+        }
+        
+        jasonNode *current = jasonDocument_Get(document, object, key, keyLen);
+        if(current != NULL)
+        {
+            jasonNode *before = current->Next;
+            value->Key = current->Key;
+            value->KeyHash = current->KeyHash;
+            jason_UnlinkNode(current);
+            return jason_LinkNode(document, object, before, value);
+        }
+        
+        if(quoted.Value == NULL)
+        {
+            jasonStatus status = jason_QuoteNodeText(document, key, (size_t)keyLen, &quoted);
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+        }
+        
+        value->Key = quoted;
+        value->KeyHash = jason_HashNodeKey(document, key, keyLen);
+        return jason_LinkNode(document, object, NULL, value);
+    }
+    
+    // put value before the element at index, an index of NumChildren appends
+    jasonStatus jasonDocument_Insert(jasonDocument *document, jasonNode *array, jasonSize index, jasonNode *value)
+    {
+        if(!jason_CanLink(array, jasonValueType_Array, value) || index < 0 || index > array->NumChildren)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        return jason_LinkNode(document, array, jasonNode_At(array, index), value);
+    }
+    
+    jasonStatus jasonDocument_Append(jasonDocument *document, jasonNode *array, jasonNode *value)
+    {
+        return jasonDocument_Insert(document, array, array->NumChildren, value);
+    }
+    
+    // put value where node is, under the same key in an object. node is left detached
+    jasonStatus jasonDocument_Replace(jasonDocument *document, jasonNode *node, jasonNode *value)
+    {
+        jasonNode *container = node->Parent;
+        if(container == NULL || !jason_CanLink(container, jasonNode_GetType(container), value))
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        jasonNode *before = node->Next;
+        value->Key = node->Key;
+        value->KeyHash = node->KeyHash;
+        jason_UnlinkNode(node);
+        return jason_LinkNode(document, container, before, value);
+    }
+    
+    // take node out of its container. It can be put back elsewhere, its memory is kept until jasonDocument_Free
+    jasonStatus jasonDocument_Remove(jasonDocument *document, jasonNode *node)
+    {
+        (void)document;
+        if(node->Parent == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_UnexpectedCharacter);
+        }
+        
+        jason_UnlinkNode(node);
+        return jasonStatus_Continue;
+    }
+    
+    // copy a value of a parsed document and everything in it into nodes. Containers skipped by jasonFlag_Lazy are expanded
+    jasonStatus jasonDocument_FromValue(jasonDocument *document, jason *jason, jasonValue *value, jasonNode **node)
+    {
+        jasonValueType type = jasonValue_GetType(value);
+        *node = NULL;
+        
+        if(type != jasonValueType_Object && type != jasonValueType_Array)
+        {
+            jasonNode *copy = jason_NewNode(document, NULL, 0);
+            if(copy == NULL || jason_CopyNodeText(document, value->Value, value->ValueLen, &copy->Value) != jasonStatus_Continue)
+            {
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            *node = copy;
+            return jasonStatus_Continue;
+        }
+        
+        jasonNode *container = (type == jasonValueType_Object) ? jasonDocument_NewObject(document) : jasonDocument_NewArray(document);
+        value = jason_ResolveLazy(&jason, value);
+        if(container == NULL || value == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        for(jasonValue *child = jasonValue_GetFirstChild(value); child != NULL; child = jasonValue_GetNextSibling(child))
+        {
+            jasonNode *member = NULL;
+            jasonStatus status = jasonDocument_FromValue(document, jason, (type == jasonValueType_Object) ? child + 1 : child, &member);
+            
+            if(status == jasonStatus_Continue && type == jasonValueType_Object)
+            {
+                status = jason_CopyNodeText(document, child->Value, child->ValueLen, &member->Key);
+                member->KeyHash = jason_HashNodeKey(document, jasonValue_GetValue(child), jasonValue_GetValueLen(child));
+            }
+            
+            if(status == jasonStatus_Continue)
+            {
+                status = jason_LinkNode(document, container, NULL, member);
+            }
+            
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+        }
+        
+        *node = container;
+        return jasonStatus_Continue;
+    }
+    
+    // the same for a value of a jasonCompactTape
+    jasonStatus jasonDocument_FromCompact(jasonDocument *document, jasonCompactTape *tape, jasonCompactValue *value, jasonNode **node)
+    {
+        jasonValueType type = jasonCompactValue_GetType(value);
+        const char *text = jasonCompactValue_GetValue(tape, value);
+        jasonSize valueLen = jasonCompactValue_GetValueLen(value);
+        *node = NULL;
+        
+        if(type != jasonValueType_Object && type != jasonValueType_Array)
+        {
+            if(type == jasonValueType_String)
+            {
+                text--;
+                valueLen = (valueLen + 2) | (jasonCompactValue_HasEscapes(value) ? JASON_STRING_ESCAPED : 0);
+            }
+            
+            jasonNode *copy = jason_NewNode(document, NULL, 0);
+            if(copy == NULL || jason_CopyNodeText(document, text, valueLen, &copy->Value) != jasonStatus_Continue)
+            {
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            *node = copy;
+            return jasonStatus_Continue;
+        }
+        
+        jasonNode *container = (type == jasonValueType_Object) ? jasonDocument_NewObject(document) : jasonDocument_NewArray(document);
+        if(container == NULL)
+        {
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        for(jasonCompactValue *child = jasonCompactValue_GetFirstChild(value); child != NULL; child = jasonCompactValue_GetNextSibling(child))
+        {
+            jasonNode *member = NULL;
+            jasonStatus status = jasonDocument_FromCompact(document, tape, (type == jasonValueType_Object) ? child + 1 : child, &member);
+            
+            if(status == jasonStatus_Continue && type == jasonValueType_Object)
+            {
+                const char *key = jasonCompactValue_GetValue(tape, child);
+                jasonSize keyLen = jasonCompactValue_GetValueLen(child);
+                status = jason_CopyNodeText(document, key - 1, (keyLen + 2) | (jasonCompactValue_HasEscapes(child) ? JASON_STRING_ESCAPED : 0), &member->Key);
+                member->KeyHash = jason_HashNodeKey(document, key, keyLen);
+            }
+            
+            if(status == jasonStatus_Continue)
+            {
+                status = jason_LinkNode(document, container, NULL, member);
+            }
+            
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+        }
+        
+        *node = container;
+        return jasonStatus_Continue;
+    }
+    
+    void jasonDocument_Free(jasonDocument *document)
+    {
+        if(document->Arena.Free != NULL)
+        {
+            jasonArena_Free(&document->Arena);
+        }
+    }
+    
+    jasonStatus jasonWriter_WriteNode(jasonWriter *writer, jasonNode *node)
+    {
+        jasonNode *it = node;
+        
+        while(writer->Status == jasonStatus_Continue)
+        {
+            if(it != node && *it->Parent->Value.Value == '{')
+            {
+                if(jasonWriter_Separate(writer) == jasonStatus_Continue && jasonWriter_Write(writer, it->Key.Value, it->Key.ValueLen & JASON_VALUELEN_MASK) == jasonStatus_Continue)
+                {
+                    jasonWriter_Write(writer, ": ", (writer->Flags & jasonWriterFlag_Pretty) ? 2 : 1);
+                }
+                
+                writer->AfterKey = 1;
+            }
+            
+            jasonValueType type = jasonNode_GetType(it);
+            if(type == jasonValueType_Object || type == jasonValueType_Array)
+            {
+                jasonWriter_Open(writer, it->Value.Value);
+                if(it->First != NULL)
+                {
+                    it = it->First;
+                    continue;
+                }
+                
+                jasonWriter_Close(writer, (type == jasonValueType_Object) ? "}" : "]");
+            }
+            else
+            {
+                jasonWriter_Raw(writer, it->Value.Value, it->Value.ValueLen & JASON_VALUELEN_MASK);
+            }
+            
+            // close every container this node was the last member of
+            while(it != node && it->Next == NULL)
+            {
+                it = it->Parent;
+                jasonWriter_Close(writer, (*it->Value.Value == '{') ? "}" : "]");
+            }
+            
+            if(it == node)
+            {
+                break;
+            }
+            
+            it = it->Next;
+        }
+        
+        return writer->Status;
+    }
+    
+    // parse a node back into a tape. The text the tape points at is kept by the jason as its File, so the tape outlives the
+    // jasonDocument and can be turned into a jasonCompactTape
+    jasonStatus jason_DeserializeNode(jason *jason, jasonNode *node)
+    {
+        if(jason->Malloc == NULL || jason->Free == NULL)
+        {
+            jason->Malloc = jason_Malloc;
+            jason->Free = jason_Free;
+            jason->Realloc = jason_Realloc;
+        }
+        
+        jasonWriter writer;
+        memset(&writer, 0, sizeof(jasonWriter));
+        writer.Malloc = jason->Malloc;
+        writer.Free = jason->Free;
+        writer.Realloc = jason->Realloc;
+        
+        jasonStatus status = jasonWriter_WriteNode(&writer, node);
+        if(status == jasonStatus_Continue)
+        {
+            status = jasonWriter_Finish(&writer);
+        }
+        
+        if(status == jasonStatus_Finished && writer.Used > (size_t)JASON_SIZE_MAX)
+        {
+            status = jasonStatus_Break(jasonStatus_IntegerOverflow);
+        }
+        
+        if(status == jasonStatus_Finished)
+        {
+            status = jason_Deserialize(jason, writer.Buffer, (jasonSize)writer.Used);
+        }
+        
+        if(status == jasonStatus_Finished)
+        {
+            jason_ReleaseFile(jason);
+            jason->File = writer.Buffer;
+            jason->FileSize = writer.Used;
+            writer.Buffer = NULL;
+        }
+        
+        jasonWriter_Free(&writer);
+        return status;
+    }
+    
+    // run task over each of numTasks elements of 'tasks', one thread each with JASON_THREADS. The calling
+    // thread takes the first, and any that cannot get a thread of their own
+    void jason_RunTasks(void *(*task)(void*), void *tasks, size_t taskSize, int32_t numTasks)
+    {
+#ifdef JASON_THREADS
+        pthread_t threads[JASON_MAX_THREADS];
+        int32_t started[JASON_MAX_THREADS];
+        
+        for(int32_t i = 1; i < numTasks && i < JASON_MAX_THREADS; i++)
+        {
+            started[i] = (pthread_create(&threads[i], NULL, task, (char*)tasks + i * taskSize) == 0);
+        }
+        
+        task(tasks);
+        
+        for(int32_t i = 1; i < numTasks; i++)
+        {
+            if(i < JASON_MAX_THREADS && started[i])
+            {
+                pthread_join(threads[i], NULL);
+            }
+            else
+            {
+                task((char*)tasks + i * taskSize);
+            }
+        }
+#else
+        for(int32_t i = 0; i < numTasks; i++)
+        {
+            task((char*)tasks + i * taskSize);
+        }
+#endif
+    }
+    
+    const char *jason_FindNewline(const char *it, const char *end)
+    {
+#if defined(JASON_X86_SIMD) && defined(__SSE2__)
+        while(end - it >= 16)
+        {
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)it), _mm_set1_epi8('\n')));
+            if(mask != 0)
+            {
+                return it + jason_CountTrailingZeros(mask);
+            }
+            
+            it += 16;
+        }
+#endif
+        while(it < end && *it != '\n')
+        {
+            it++;
+        }
+        
+        return it;
+    }
+    
+    // parse the lines of one worker's share, either handing each document to the callback or packing its tape
+    void jason_ParseLines(jasonBatchWorker *worker)
+    {
+        jasonBatch *batch = worker->Batch;
+        jason *document = &worker->Document;
+        const char *line = worker->Begin;
+        
+        worker->NumLines = 0;
+        worker->TapeUsed = 0;
+        worker->Status = jasonStatus_Continue;
+        document->Flags = batch->Flags;
+        if(batch->Callback == NULL)
+        {
+            // a packed tape has no document to expand its lazy containers into
+            document->Flags &= ~(uint32_t)jasonFlag_Lazy;
+        }
+        
+        while(line < worker->End && worker->Status == jasonStatus_Continue)
+        {
+            const char *lineEnd = jason_FindNewline(line, worker->End);
+            const char *first = line;
+            JASON_SKIPWHITESPACE(first, lineEnd);
+            
+            if(first < lineEnd)
+            {
+                jasonStatus status = jason_Deserialize(document, line, (jasonSize)(lineEnd - line));
+                
+                if(batch->Callback != NULL)
+                {
+                    batch->Callback(batch->Context, line, (jasonSize)(lineEnd - line), document, status);
+                }
+                else
+                {
+                    jasonSize numValues = (status == jasonStatus_Finished) ? document->NumValues : 0;
+                    worker->Status = jason_GrowBuffer(document, (void**)&worker->Lines, &worker->LinesSize, (size_t)(worker->NumLines + 1) * sizeof(jasonLine));
+                    if(worker->Status == jasonStatus_Continue)
+                    {
+                        worker->Status = jason_GrowBuffer(document, (void**)&worker->Tape, &worker->TapeSize, (size_t)(worker->TapeUsed + numValues) * sizeof(jasonValue));
+                    }
+                    
+                    if(worker->Status != jasonStatus_Continue)
+                    {
+                        break;
+                    }
+                    
+                    jasonLine *result = worker->Lines + worker->NumLines++;
+                    result->Root = NULL;
+                    result->NumValues = numValues;
+                    result->Offset = (jasonSize)(line - worker->Begin); // made absolute when the workers are merged
+                    result->Status = status;
+                    
+                    if(numValues > 0)
+                    {
+                        // a line that failed has no tape to copy
+                        memcpy(worker->Tape + worker->TapeUsed, document->RootValue, numValues * sizeof(jasonValue));
+                        worker->TapeUsed += numValues;
+                    }
+                }
+            }
+            
+            line = (lineEnd < worker->End) ? lineEnd + 1 : lineEnd;
+        }
+        
+        // the tape has stopped moving, point the lines into it
+        jasonValue *root = worker->Tape;
+        for(jasonSize i = 0; i < worker->NumLines; i++)
+        {
+            jasonLine *result = worker->Lines + i;
+            result->Root = (result->NumValues > 0) ? root : NULL;
+            root += result->NumValues;
+        }
+    }
+    
+    void *jason_ParseLinesTask(void *worker)
+    {
+        jason_ParseLines((jasonBatchWorker*)worker);
+        return NULL;
+    }
+    
+    // parse newline-delimited documents (NDJSON, JSON Lines) split across NumThreads workers. Blank lines are
+    // skipped, a line that fails to parse only sets its own Status
+    jasonStatus jason_DeserializeLines(jasonBatch *batch, const char *text, jasonSize textLen)
+    {
+        if(batch->Malloc == NULL)
+        {
+            batch->Malloc = jason_Malloc;
+        }
+        
+        if(batch->Free == NULL)
+        {
+            batch->Free = jason_Free;
+        }
+        
+        batch->NumLines = 0;
+        
+        if(text == NULL || textLen <= 0)
+        {
+            return jasonStatus_Finished;
+        }
+        
+        // small inputs are not worth a thread each
+        int32_t numWorkers = batch->NumThreads > 0 ? batch->NumThreads : 1;
+        if((jasonSize)numWorkers > textLen / JASON_BATCH_MIN_BYTES + 1)
+        {
+            numWorkers = (int32_t)(textLen / JASON_BATCH_MIN_BYTES + 1);
+        }
+        
+        if(numWorkers > JASON_MAX_THREADS)
+        {
+            numWorkers = JASON_MAX_THREADS;
+        }
+        
+        if(numWorkers > batch->NumWorkers)
+        {
+            size_t memLength = numWorkers * sizeof(jasonBatchWorker);
+            jasonBatchWorker *workers = batch->Malloc(&memLength);
+            if(workers == NULL || memLength < numWorkers * sizeof(jasonBatchWorker))
+            {
+                batch->Free(workers);
+                return jasonStatus_Break(jasonStatus_OutOfMemory);
+            }
+            
+            memset(workers, 0, numWorkers * sizeof(jasonBatchWorker));
+            if(batch->Workers != NULL)
+            {
+                memcpy(workers, batch->Workers, batch->NumWorkers * sizeof(jasonBatchWorker));
+                batch->Free(batch->Workers);
+            }
+            
+            for(int32_t i = batch->NumWorkers; i < numWorkers; i++)
+            {
+                workers[i].Document.Malloc = batch->Malloc;
+                workers[i].Document.Free = batch->Free;
+                workers[i].Document.Realloc = batch->Realloc;
+            }
+            
+            batch->Workers = workers;
+            batch->NumWorkers = numWorkers;
+        }
+        
+        // equal shares of bytes, each moved forward to the start of a line
+        const char *end = text + textLen;
+        const char *begin = text;
+        for(int32_t i = 0; i < numWorkers; i++)
+        {
+            jasonBatchWorker *worker = batch->Workers + i;
+            const char *shareEnd = (i == numWorkers - 1) ? end : text + textLen / numWorkers * (i + 1);
+            
+            if(shareEnd < begin)
+            {
+                shareEnd = begin;
+            }
+            
+            shareEnd = jason_FindNewline(shareEnd, end);
+            worker->Batch = batch;
+            worker->Begin = begin;
+            worker->End = shareEnd;
+            begin = (shareEnd < end) ? shareEnd + 1 : end;
+        }
+        
+        jason_RunTasks(jason_ParseLinesTask, batch->Workers, sizeof(jasonBatchWorker), numWorkers);
+        
+        jasonSize numLines = 0;
+        for(int32_t i = 0; i < numWorkers; i++)
+        {
+            if(batch->Workers[i].Status != jasonStatus_Continue)
+            {
+                return batch->Workers[i].Status;
+            }
+            
+            numLines += batch->Workers[i].NumLines;
+        }
+        
+        if(batch->Callback != NULL)
+        {
+            return jasonStatus_Finished;
+        }
+        
+        jasonStatus status = jason_GrowBuffer(&batch->Workers[0].Document, (void**)&batch->Lines, &batch->LinesSize, (size_t)numLines * sizeof(jasonLine));
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        for(int32_t i = 0; i < numWorkers; i++)
+        {
+            jasonBatchWorker *worker = batch->Workers + i;
+            jasonLine *lines = batch->Lines + batch->NumLines;
+            memcpy(lines, worker->Lines, worker->NumLines * sizeof(jasonLine));
+            
+            for(jasonSize l = 0; l < worker->NumLines; l++)
+            {
+                lines[l].Offset += (jasonSize)(worker->Begin - text);
+            }
+            
+            batch->NumLines += worker->NumLines;
+        }
+        
+        return jasonStatus_Finished;
+    }
+    
+    void jasonBatch_Free(jasonBatch *batch)
+    {
+        for(int32_t i = 0; i < batch->NumWorkers; i++)
+        {
+            jasonBatchWorker *worker = batch->Workers + i;
+            jason_Cleanup(&worker->Document);
+            batch->Free(worker->Tape);
+            batch->Free(worker->Lines);
+        }
+        
+        if(batch->Free != NULL)
+        {
+            batch->Free(batch->Workers);
+            batch->Free(batch->Lines);
+        }
+        
+        batch->Workers = NULL;
+        batch->NumWorkers = 0;
+        batch->Lines = NULL;
+        batch->LinesSize = 0;
+        batch->NumLines = 0;
+    }
+    
+    // first pass of jason_DeserializeParallel: string state and bracket depth of one segment, worked out for
+    // both states it could start in, since that depends on every segment before it
+    void *jason_ClassifySegmentTask(void *task)
+    {
+        jasonSegment *segment = (jasonSegment*)task;
+        jasonClassifyBlockCb_t classify = jason_SelectClassifier();
+        jasonSize len = (jasonSize)(segment->End - segment->Begin);
+        jasonSize depth[2] = { 0, 0 };
+        uint64_t prevEscaped = 0;
+        uint64_t prevInString = 0;
+        
+        for(int32_t h = 0; h < 2; h++)
+        {
+            segment->Brackets[h].MinCommaDepth = JASON_SIZE_MAX;
+            segment->Brackets[h].FirstMinComma = NULL;
+        }
+        
+        for(jasonSize blockStart = 0; blockStart < len; blockStart += 64)
+        {
+            const char *block = segment->Begin + blockStart;
+            char padded[64];
+            if(len - blockStart < 64)
+            {
+                memset(padded, ' ', sizeof(padded));
+                memcpy(padded, block, len - blockStart);
+                block = padded;
+            }
+            
+            jasonBlockMasks masks;
+            classify(block, &masks);
+            
+            uint64_t escaped = jason_FindEscaped(masks.Backslash, &prevEscaped);
+            uint64_t inString = jason_PrefixXor(masks.Quote & ~escaped) ^ prevInString;
+            prevInString = (uint64_t)((int64_t)inString >> 63);
+            
+            for(int32_t h = 0; h < 2; h++)
+            {
+                jasonSegmentBrackets *brackets = segment->Brackets + h;
+                for(uint64_t bits = masks.Structural & (h ? inString : ~inString); bits != 0; bits &= bits - 1)
+                {
+                    int offset = jason_CountTrailingZeros(bits);
+                    switch(block[offset])
+                    {
+                        case '{':
+                        case '[':
+                            depth[h]++;
+                            break;
+                            
+                        case '}':
+                        case ']':
+                            depth[h]--;
+                            break;
+                            
+                        case ',':
+                            if(depth[h] < brackets->MinCommaDepth)
+                            {
+                                brackets->MinCommaDepth = depth[h];
+                                brackets->FirstMinComma = segment->Begin + blockStart + offset;
+                            }
+                            break;
+                    }
+                }
+            }
+        }
+        
+        segment->Brackets[0].DepthChange = depth[0];
+        segment->Brackets[1].DepthChange = depth[1];
+        segment->QuoteParity = (int32_t)(prevInString & 1);
+        return NULL;
+    }
+    
+    // second pass: parse one run of root array elements. Pieces after the first open a stand-in for the root,
+    // so their elements attach to it exactly as they would in a single pass
+    void *jason_ParseSegmentTask(void *task)
+    {
+        jasonSegment *segment = (jasonSegment*)task;
+        jason *document = &segment->Document;
+        jasonStatus status = jason_Begin(document);
+        document->ParsePosition = segment->PieceBegin;
+        
+        if(status == jasonStatus_Continue && !segment->IsFirst)
+        {
+            jasonValue *root = document->RootValue;
+            root->Value = segment->RootBracket;
+            root->ValueLen = 0;
+            root->Next = 0;
+            document->NumValues = 1;
+            status = jason_PushFrame(document, 0);
+            if(status == jasonStatus_Continue)
+            {
+                // the piece starts after a comma between the root's elements
+                document->Stack[0].Separated = 1;
+            }
+        }
+        
+        if(status == jasonStatus_Continue && (document->Flags & jasonFlag_PreCount))
+        {
+            status = jason_ReserveValues(document, jason_CountValues(segment->PieceBegin, (jasonSize)(segment->PieceEnd - segment->PieceBegin)) + 1);
+        }
+        
+        if(status == jasonStatus_Continue && (document->Flags & jasonFlag_StructuralIndex))
+        {
+            status = jason_BuildStructuralIndex(document, segment->PieceBegin, (jasonSize)(segment->PieceEnd - segment->PieceBegin));
+        }
+        
+        if(status == jasonStatus_Continue)
+        {
+            status = jason_DeserializeStep(document, segment->PieceEnd, segment->IsLast);
+        }
+        
+        document->Free(document->StructuralIndex.Positions);
+        document->StructuralIndex.Positions = NULL;
+        
+        // every piece but the last stops straight after a separating comma, waiting for the next element
+        if(!segment->IsLast && status == jasonStatus_Continue && (document->Depth != 1 || document->ParseState != jasonParseState_Value))
+        {
+            status = jasonStatus_Break(jasonStatus_UnexpectedEndOfString);
+        }
+        
+        segment->Status = status;
+        return NULL;
+    }
+    
+    // append a piece's tape, decoded numbers and object indexes to the document being stitched together
+    jasonStatus jason_StitchSegment(jason *jason, jasonSegment *segment, jasonSize *lastElement)
+    {
+        jasonValue *tape = segment->Document.RootValue;
+        jasonSize skip = segment->IsFirst ? 0 : 1; // the stand-in root
+        jasonSize base = jason->NumValues - skip;
+        jasonSize count = segment->Document.NumValues - skip;
+        
+        jasonStatus status = jason_ReserveValues(jason, jason->NumValues + count);
+        if(status != jasonStatus_Continue)
+        {
+            return status;
+        }
+        
+        memcpy(jason->RootValue + jason->NumValues, tape + skip, count * sizeof(jasonValue));
+        if((jason->Flags & jasonFlag_DecodeNumbers) && segment->Document.Numbers != NULL)
+        {
+            memcpy(jason->Numbers + jason->NumValues, segment->Document.Numbers + skip, count * sizeof(jasonNumber));
+        }
+        
+        jason->NumValues += count;
+        
+        if(tape->ValueLen > 0)
+        {
+            // chain the root's elements across the pieces
+            jasonSize first = base + 1;
+            if(*lastElement > 0)
+            {
+                jason->RootValue[*lastElement].Next = first - *lastElement;
+            }
+            
+            jasonSize last = 1;
+            while(tape[last].Next != 0)
+            {
+                last += tape[last].Next;
+            }
+            
+            *lastElement = base + last;
+            jason->RootValue->ValueLen += segment->IsFirst ? 0 : tape->ValueLen;
+        }
+        
+        jasonHashTable *table = &segment->Document.KeyLookupTable;
+        for(int32_t i = 0; i < table->DirectorySize && table->NumIndexed > 0; i++)
+        {
+            jasonObjectIndex index = table->Directory[i];
+            if(index.Capacity == 0)
+            {
+                continue;
+            }
+            
+            // the slots hold offsets from their object, so they move over as they are
+            size_t bytes = (size_t)index.Capacity * (1 + sizeof(jasonSize));
+            status = jason_GrowBuffer(jason, (void**)&jason->KeyLookupTable.Slots, &jason->KeyLookupTable.SlotsSize, jason->KeyLookupTable.SlotsUsed + bytes);
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+            
+            memcpy(jason->KeyLookupTable.Slots + jason->KeyLookupTable.SlotsUsed, table->Slots + index.Offset, bytes);
+            index.Object += base;
+            index.Offset = jason->KeyLookupTable.SlotsUsed;
+            jason->KeyLookupTable.SlotsUsed += bytes;
+            
+            status = jason_AddObjectIndex(jason, &index);
+            if(status != jasonStatus_Continue)
+            {
+                return status;
+            }
+        }
+        
+        return jasonStatus_Continue;
+    }
+    
+    // parse a document whose root is an array on numThreads threads. The input is cut where the root's elements
+    // are separated, the pieces are parsed side by side and their tapes joined, so the result is the same as
+    // jason_Deserialize's. Anything else, including every error, goes through jason_Deserialize
+    jasonStatus jason_DeserializeParallel(jason *jason, const char *json, jasonSize jsonLen, int32_t numThreads)
+    {
+        int32_t numSegments = numThreads < JASON_MAX_THREADS ? numThreads : JASON_MAX_THREADS;
+        if((jasonSize)numSegments > jsonLen / JASON_PARALLEL_MIN_BYTES)
+        {
+            numSegments = (int32_t)(jsonLen / JASON_PARALLEL_MIN_BYTES);
+        }
+        
+        const char *rootBracket = json;
+        const char *end = json + (jsonLen > 0 ? jsonLen : 0);
+        if(json != NULL)
+        {
+            JASON_SKIPWHITESPACE(rootBracket, end);
+        }
+        
+        if(json == NULL || numSegments < 2 || rootBracket >= end || *rootBracket != '[' || jason->Projection != NULL)
+        {
+            return jason_Deserialize(jason, json, jsonLen);
+        }
+        
+        jasonStatus status = jason_Begin(jason);
+        size_t memLength = numSegments * sizeof(jasonSegment);
+        jasonSegment *segments = (status == jasonStatus_Continue) ? jason->Malloc(&memLength) : NULL;
+        if(segments == NULL || memLength < numSegments * sizeof(jasonSegment))
+        {
+            jason->Free(segments);
+            return jasonStatus_Break(jasonStatus_OutOfMemory);
+        }
+        
+        memset(segments, 0, numSegments * sizeof(jasonSegment));
+        
+        const char *begin = json;
+        for(int32_t i = 0; i < numSegments; i++)
+        {
+            const char *segmentEnd = (i == numSegments - 1) ? end : json + jsonLen / numSegments * (i + 1);
+            while(segmentEnd < end && segmentEnd > begin && segmentEnd[-1] == '\\')
+            {
+                segmentEnd++;
+            }
+            
+            segments[i].Begin = begin;
+            segments[i].End = segmentEnd;
+            begin = segmentEnd;
+        }
+        
+        jason_RunTasks(jason_ClassifySegmentTask, segments, sizeof(jasonSegment), numSegments);
+        
+        // carry the string state and depth across the segments, and cut at the first root-level comma in each
+        int32_t numPieces = 0;
+        int32_t inString = 0;
+        jasonSize depth = 0;
+        const char *pieceBegin = json;
+        
+        for(int32_t i = 0; i < numSegments; i++)
+        {
+            jasonSegmentBrackets *brackets = segments[i].Brackets + inString;
+            if(i > 0 && brackets->FirstMinComma != NULL && depth + brackets->MinCommaDepth == 1)
+            {
+                jasonSegment *piece = segments + numPieces++;
+                piece->PieceBegin = pieceBegin;
+                piece->PieceEnd = brackets->FirstMinComma + 1;
+                pieceBegin = piece->PieceEnd;
+            }
+            
+            depth += brackets->DepthChange;
+            inString ^= segments[i].QuoteParity;
+        }
+        
+        jasonSegment *lastPiece = segments + numPieces++;
+        lastPiece->PieceBegin = pieceBegin;
+        lastPiece->PieceEnd = end;
+        
+        for(int32_t i = 0; i < numPieces; i++)
+        {
+            segments[i].Document.Malloc = jason->Malloc;
+            segments[i].Document.Free = jason->Free;
+            segments[i].Document.Realloc = jason->Realloc;
+            segments[i].Document.Hash = jason->Hash;
+            segments[i].Document.HashSeed = jason->HashSeed;
+            segments[i].Document.Flags = jason->Flags;
+            segments[i].Document.MaxDepth = jason->MaxDepth;
+            segments[i].Document.ExpectedValues = jason->ExpectedValues / numPieces;
+            segments[i].RootBracket = rootBracket;
+            segments[i].IsFirst = (i == 0);
+            segments[i].IsLast = (i == numPieces - 1);
+        }
+        
+        if(numPieces > 1)
+        {
+            jason_RunTasks(jason_ParseSegmentTask, segments, sizeof(jasonSegment), numPieces);
+            
+            for(int32_t i = 0; i < numPieces && status == jasonStatus_Continue; i++)
+            {
+                if(segments[i].Status != (segments[i].IsLast ? jasonStatus_Finished : jasonStatus_Continue))
+                {
+                    status = jasonStatus_UnexpectedCharacter;
+                }
+            }
+            
+            jasonSize lastElement = 0;
+            for(int32_t i = 0; i < numPieces && status == jasonStatus_Continue; i++)
+            {
+                status = jason_StitchSegment(jason, segments + i, &lastElement);
+            }
+        }
+        
+        for(int32_t i = 0; i < numPieces; i++)
+        {
+            if(segments[i].Document.Free != NULL)
+            {
+                jason_Cleanup(&segments[i].Document);
+            }
+        }
+        
+        jason->Free(segments);
+        
+        if(numPieces < 2 || status != jasonStatus_Continue)
+        {
+            // no place to cut, or a piece failed: let the sequential parser have it and report the error its way
+            return jason_Deserialize(jason, json, jsonLen);
+        }
+        
+        jason->ParseState = jasonParseState_Done;
+        jason->ParsePosition = json;
+        jason->Depth = 0;
+        return jasonStatus_Finished;
     }
     
 #ifdef __cplusplus